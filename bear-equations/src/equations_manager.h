@@ -13,6 +13,7 @@
 #include <memory>
 #include "def.h"
 #include "logger.h"
+#include "results_writer.h"
 namespace bear
 {
 
@@ -59,6 +60,12 @@ namespace bear
             return eq_type::fvarmap;
         }
         
+        // results of the run (shared by the policies)
+        const bear_summary& get_summary() const
+        {
+            return *fSummary;
+        }
+        
         
         int init()
         {
@@ -84,6 +91,7 @@ namespace bear
             //needed for printing table
             gui_type::init(eq_type::fVarmap_input_file,eq_type::fvarmap);
             gui_type::init(solve_eq_type::fGeneral_solution);
+            gui_type::init(solve_eq_type::fTable);
             
             
             return 0;
@@ -91,153 +99,33 @@ namespace bear
         
         int save()
         {
-            INIT_NEW_FILE(fSummary->outfilename,EQUAL,RESULTS);
-            double Xmin=eq_type::fVarmap_input_file.at("thickness.minimum").template as<double>();
-            double Xmax=eq_type::fVarmap_input_file.at("thickness.maximum").template as<double>();
-            size_t Npoint=eq_type::fVarmap_input_file.at("thickness.point.number").template as<std::size_t>();
-            
-            double Ymin=eq_type::fVarmap_input_file.at("fraction.minimum").template as<double>();
-            double Ymax=eq_type::fVarmap_input_file.at("fraction.maximum").template as<double>();
-            
-            std::string proj_symbol=eq_type::fVarmap_input_file.at("projectile.symbol").template as<std::string>();
-            std::string proj_energy=eq_type::fVarmap_input_file.at("projectile.energy").template as<std::string>();
-            std::string target_symbol=eq_type::fVarmap_input_file.at("target.symbol").template as<std::string>();
-            int tmass=(int)eq_type::fVarmap_input_file.at("target.mass.number").template as<double>();
-            std::string target_mass=std::to_string(tmass);
-            std::string target_pressure=eq_type::fVarmap_input_file.at("target.pressure").template as<std::string>();
-            std::string X_unit=eq_type::fVarmap_input_file.at("thickness.unit").template as<std::string>();
-            
-            std::stringstream ss;
-            
-            ss<<proj_symbol
-                    <<" projectile at "
-                    <<proj_energy
-                    //<<" on ^{"
-                    <<" on "
-                    <<target_mass//<<"}"
-                    <<target_symbol
-                    <<" target"
-                    ;
-            ss<<" with "<< target_pressure <<" pressure.";
-            
-            
-            LOG(RESULTS)<<" ";
-            LOG(RESULTS)<<"##########################################################################";
-            LOG(RESULTS)<<"#                          BEAR  -  RESULTS                              #";
-            LOG(RESULTS)<<"##########################################################################";
-            LOG(RESULTS)<<" ";
-            
-            LOG(RESULTS)<<"Title : "<<ss.str();
-            LOG(RESULTS)<<" ";
-            LOG(RESULTS)<<"Computed from input file : "<<fSummary->filename;
-            LOG(RESULTS)<<" ";
-            LOG(RESULTS)<<"Found a "<< fSummary->system_dim <<" level system\n";
-            LOG(RESULTS)<<" ";
-            
-            
-            bool print_equilibrium=eq_type::fvarmap["save-equilibrium"].template as<bool>();
-            
-            if(print_equilibrium)
+            std::string output_format=eq_type::fvarmap["output-format"].template as<std::string>();
+            std::string table_format=eq_type::fvarmap["table-format"].template as<std::string>();
+            table_writer::format format;
+            if(table_writer::parse_format(table_format,format))
             {
-                
-                LOG(RESULTS)<<"##########################################################################";
-                LOG(RESULTS)<<"#                EQUILIBRIUM CHARGE STATE DISTRIBUTION                   #";
-                LOG(RESULTS)<<"##########################################################################";
-                LOG(RESULTS)<<" ";
-                double sum=0;
-                double mean=0;
-                for(const auto& p : fSummary->equilibrium_solutions)
-                {
-                    double Fi=p.second;
-                    double qi=fSummary->F_index_map.at(p.first);
-                    mean+=qi*Fi;
-                    sum+=Fi;
-                    LOG(RESULTS)  << "F"
-                                << std::to_string(fSummary->F_index_map.at(p.first))
-                                << " = "
-                                << Fi;
-                }
-                LOG(RESULTS)<<"sum = "<<sum;
-                LOG(RESULTS)<<"<q> = "<<mean;
+                LOG(ERROR)<<"unknown table format '"<<table_format<<"' (scientific or round-trip)";
+                return 1;
             }
-            ////////////////////////////////////////////////////////////////////////////////////////
-            
-            bool print_approximation=eq_type::fvarmap["save-approximation"].template as<bool>();
             
-            if(print_approximation)
+            fs::path prefix(fSummary->outfilename);
+            prefix.replace_extension("");
+            std::unique_ptr<results_writer> writer=make_results_writer(output_format,prefix.string(),format);
+            if(!writer)
             {
-                double sum=0;
-                double mean=0;
-                LOG(RESULTS)<<" ";
-                LOG(RESULTS)<<"##########################################################################";
-                LOG(RESULTS)<<"#  EQUILIBRIUM CHARGE STATE DISTRIBUTION  (1-electron approximation)     #";
-                LOG(RESULTS)<<"##########################################################################";
-                LOG(RESULTS)<<" ";
-                for(const auto& p : fSummary->approximated_solutions)
-                {
-                    double Fi=p.second;
-                    double qi=fSummary->F_index_map.at(p.first);
-                    mean+=qi*Fi;
-                    sum+=Fi;
-                    LOG(RESULTS)  << "F"
-                                << std::to_string(fSummary->F_index_map.at(p.first))
-                                << " = "
-                                << Fi;
-                }
-                LOG(RESULTS)<<"sum = "<<sum;
-                LOG(RESULTS)<<"<q> = "<<mean;
-            }
-                
-            
-            ////////////////////////////////////////////////////////////////////////////////////////
-            
-            bool save_table=eq_type::fvarmap["save-table"].template as<bool>();
-            bool save_analytic=eq_type::fvarmap["save-analytic"].template as<bool>();
-            bool save_fig_ne=eq_type::fvarmap["save-fig-ne"].template as<bool>();
-            
-            
-            if(save_table || save_analytic)
-            {
-                LOG(RESULTS)<<" ";
-                LOG(RESULTS)<<"##########################################################################";
-                LOG(RESULTS)<<"#             NON-EQUILIBRIUM CHARGE STATE DISTRIBUTION                  #";
-                LOG(RESULTS)<<"##########################################################################";
-                LOG(RESULTS)<<" ";
+                LOG(ERROR)<<"unknown output format '"<<output_format<<"' (text, csv, npy or raw)";
+                return 1;
             }
-                
-            
             
-            if(save_analytic)
+            if(write_results(*writer) || writer->close())
             {
-                LOG(RESULTS)<<"##################################";
-                LOG(RESULTS)<<"#computed analytical formulae :";
-                for(const auto& p : fSummary->analytical_solutions)
-                {
-                    LOG(RESULTS)   <<" ";
-                    LOG(RESULTS)   << "F"
-                                << std::to_string(fSummary->F_index_map.at(p.first))
-                                << "(x) = "
-                                << p.second;
-                    LOG(RESULTS)   <<" ";
-                }
-            }
-            
-            
-            
-            
-            if(save_table)
-            {
-                LOG(RESULTS)<<" ";
-                LOG(RESULTS)<<"##################################";
-                LOG(RESULTS)<<"#TABLE :";
-                LOG(RESULTS)<<"X unit : "<<X_unit;
-                LOG(RESULTS)<<"X range : "<<Xmin<<" - "<<Xmax;
-                LOG(RESULTS)<<"Point number : "<<Npoint;
-                gui_type::print_table();
+                LOG(ERROR)<<"could not write the results to "<<writer->location();
+                return 1;
             }
-            LOG(INFO)<<"- saving output to : "<<fSummary->outfilename;
+            LOG(INFO)<<"- saving output to : "<<writer->location();
             
             
+            bool save_fig_ne=eq_type::fvarmap["save-fig-ne"].template as<bool>();
             if(save_fig_ne)
             {
                 /*
@@ -257,6 +145,122 @@ namespace bear
             return 0;
         }
         
+        // results selected by the save-* options, written into the results channel
+        int write_results(results_writer& writer)
+        {
+            results_writer::run_info info;
+            info.title=title();
+            info.input_file=fSummary->filename;
+            info.system_dim=fSummary->system_dim;
+            info.max_fraction_index=fSummary->max_fraction_index;
+            for(const auto& p : fSummary->F_index_map)
+                info.charge_states.push_back(p.second);
+            info.sampling=eq_type::fvarmap["sampling"].template as<std::string>();
+            info.input_json=input_header_json();
+            if(writer.write_run(info))
+                return 1;
+            
+            if(eq_type::fvarmap["save-equilibrium"].template as<bool>())
+                if(write_fractions(writer,results_writer::kEquilibrium,fSummary->equilibrium_solutions))
+                    return 1;
+            
+            if(eq_type::fvarmap["save-approximation"].template as<bool>())
+                if(write_fractions(writer,results_writer::kApproximation,fSummary->approximated_solutions))
+                    return 1;
+            
+            if(eq_type::fvarmap["save-analytic"].template as<bool>())
+            {
+                std::vector<int> charge_states;
+                std::vector<std::string> formulae;
+                for(const auto& p : fSummary->analytical_solutions)
+                {
+                    charge_states.push_back(fSummary->F_index_map.at(p.first));
+                    formulae.push_back(p.second);
+                }
+                if(writer.write_formulae(charge_states,formulae))
+                    return 1;
+            }
+            
+            if(eq_type::fvarmap["save-table"].template as<bool>())
+            {
+                results_writer::table_info table;
+                table.unit=eq_type::fVarmap_input_file.at("thickness.unit").template as<std::string>();
+                table.minimum=eq_type::fVarmap_input_file.at("thickness.minimum").template as<double>();
+                table.maximum=eq_type::fVarmap_input_file.at("thickness.maximum").template as<double>();
+                table.point_number=eq_type::fVarmap_input_file.at("thickness.point.number").template as<std::size_t>();
+                table.charge_states=info.charge_states;
+                if(gui_type::print_table(writer,table))
+                    return 1;
+            }
+            return 0;
+        }
+        
+        int write_fractions(results_writer& writer, results_writer::fractions_type type, const std::map<size_t,double>& fractions)
+        {
+            std::vector<int> charge_states;
+            std::vector<double> values;
+            for(const auto& p : fractions)
+            {
+                charge_states.push_back(fSummary->F_index_map.at(p.first));
+                values.push_back(p.second);
+            }
+            return writer.write_fractions(type,charge_states,values);
+        }
+        
+        // title of the run from the header of the input file
+        std::string title()
+        {
+            std::string proj_symbol=eq_type::fVarmap_input_file.at("projectile.symbol").template as<std::string>();
+            std::string proj_energy=eq_type::fVarmap_input_file.at("projectile.energy").template as<std::string>();
+            std::string target_symbol=eq_type::fVarmap_input_file.at("target.symbol").template as<std::string>();
+            int tmass=(int)eq_type::fVarmap_input_file.at("target.mass.number").template as<double>();
+            std::string target_mass=std::to_string(tmass);
+            std::string target_pressure=eq_type::fVarmap_input_file.at("target.pressure").template as<std::string>();
+            
+            std::stringstream ss;
+            
+            ss<<proj_symbol
+                    <<" projectile at "
+                    <<proj_energy
+                    //<<" on ^{"
+                    <<" on "
+                    <<target_mass//<<"}"
+                    <<target_symbol
+                    <<" target"
+                    ;
+            ss<<" with "<< target_pressure <<" pressure.";
+            return ss.str();
+        }
+        
+        // header of the input file (cross-sections excepted) as a json object
+        std::string input_header_json()
+        {
+            std::string json="{";
+            for(const auto& p : eq_type::fVarmap_input_file)
+            {
+                const std::string& key=p.first;
+                if(key.compare(0,14,"cross.section.")==0 && key!="cross.section.unit")
+                    continue;
+                
+                std::string value;
+                const boost::any& any_value=p.second.value();
+                if(any_value.type()==typeid(std::string))
+                    value=json_string(boost::any_cast<std::string>(any_value));
+                else if(any_value.type()==typeid(double))
+                    value=json_number(boost::any_cast<double>(any_value));
+                else if(any_value.type()==typeid(std::size_t))
+                    value=std::to_string(boost::any_cast<std::size_t>(any_value));
+                else
+                    continue;
+                
+                if(json.size()>1)
+                    json+=", ";
+                json+=json_string(key)+": "+value;
+            }
+            json+="}";
+            return json;
+        }
+        
         int plot()
         {
             gui_type::plot();
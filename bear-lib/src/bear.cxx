@@ -0,0 +1,245 @@
+/*
+ * File:   bear.cxx
+ *
+ * Created on October 17, 2026
+ */
+
+// C API of libbear over the reentrant core (bear_core.h) : no ROOT, no logging,
+// and no C++ exception goes through the C functions
+
+#include <new>
+#include <string>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+#include "bear.h"
+#include "bear_core.h"
+#include "units.h"
+
+struct bear_problem_s
+{
+    bear::bear_problem problem;
+};
+
+struct bear_solution_s
+{
+    bear::bear_result result;
+};
+
+int bear_api_version(void)
+{
+    return BEAR_API_VERSION;
+}
+
+int bear_scale_factor(const char* cross_section_unit, const char* thickness_unit,
+                      double target_mass_number, double* factor)
+{
+    if(!cross_section_unit || !thickness_unit || !factor || !(target_mass_number>0.))
+        return BEAR_ERROR;
+    try
+    {
+        return bear::scale_factor(cross_section_unit,thickness_unit,target_mass_number,*factor) ? BEAR_ERROR : BEAR_OK;
+    }
+    catch(std::exception&)
+    {
+        return BEAR_ERROR;
+    }
+}
+
+bear_problem_t* bear_problem_create(size_t levels, int charge_min,
+                                    const double* cross_sections, double scale_factor)
+{
+    if(levels<2 || !cross_sections)
+        return nullptr;
+    try
+    {
+        bear_problem_t* handle=new bear_problem_t;
+        bear::bear_problem& problem=handle->problem;
+        problem.charge_states.resize(levels);
+        problem.cross_sections.resize(levels,levels,false);
+        for(size_t i(0); i<levels; i++)
+        {
+            problem.charge_states[i]=charge_min+static_cast<int>(i);
+            for(size_t j(0); j<levels; j++)
+                problem.cross_sections(i,j)= i==j ? 0. : cross_sections[i*levels+j]*scale_factor;
+        }
+        return handle;
+    }
+    catch(std::exception&)
+    {
+        return nullptr;
+    }
+}
+
+void bear_problem_destroy(bear_problem_t* problem)
+{
+    delete problem;
+}
+
+int bear_problem_set_initial_condition(bear_problem_t* problem, const double* fractions)
+{
+    if(!problem)
+        return BEAR_ERROR;
+    try
+    {
+        bear::bear_problem::vector_d& F0=problem->problem.initial_condition;
+        if(!fractions)
+        {
+            F0.resize(0,false);
+            return BEAR_OK;
+        }
+        F0.resize(problem->problem.charge_states.size(),false);
+        std::copy(fractions,fractions+F0.size(),F0.begin());
+        return BEAR_OK;
+    }
+    catch(std::exception&)
+    {
+        return BEAR_ERROR;
+    }
+}
+
+int bear_problem_set_scan(bear_problem_t* problem, size_t K, const double* fractions)
+{
+    if(!problem)
+        return BEAR_ERROR;
+    try
+    {
+        bear::bear_problem::matrix_d& F0s=problem->problem.initial_conditions;
+        const size_t levels=problem->problem.charge_states.size();
+        if(!fractions || K==0)
+        {
+            F0s.resize(0,0,false);
+            return BEAR_OK;
+        }
+        F0s.resize(levels,K,false);
+        std::copy(fractions,fractions+levels*K,&F0s.data()[0]);
+        return BEAR_OK;
+    }
+    catch(std::exception&)
+    {
+        return BEAR_ERROR;
+    }
+}
+
+int bear_problem_set_method(bear_problem_t* problem, int method)
+{
+    if(!problem || (method!=BEAR_DIAGONALIZATION && method!=BEAR_PROPAGATOR))
+        return BEAR_ERROR;
+    problem->problem.propagator = method==BEAR_PROPAGATOR;
+    return BEAR_OK;
+}
+
+bear_solution_t* bear_problem_solve(const bear_problem_t* problem)
+{
+    try
+    {
+        bear_solution_t* solution=new bear_solution_t;
+        if(problem)
+            solution->result=bear::bear_solve(problem->problem);
+        return solution;
+    }
+    catch(std::exception&)
+    {
+        return nullptr;
+    }
+}
+
+void bear_solution_destroy(bear_solution_t* solution)
+{
+    delete solution;
+}
+
+int bear_solution_status(const bear_solution_t* solution)
+{
+    if(!solution || solution->result.status())
+        return BEAR_ERROR;
+    return BEAR_OK;
+}
+
+const char* bear_solution_error(const bear_solution_t* solution)
+{
+    if(!solution)
+        return "no solution";
+    return solution->result.error().c_str();
+}
+
+size_t bear_solution_levels(const bear_solution_t* solution)
+{
+    if(bear_solution_status(solution))
+        return 0;
+    return solution->result.levels();
+}
+
+int bear_solution_equilibrium(const bear_solution_t* solution, double* fractions)
+{
+    if(bear_solution_status(solution) || !fractions)
+        return BEAR_ERROR;
+    const bear::bear_problem::vector_d& F=solution->result.equilibrium();
+    std::copy(F.begin(),F.end(),fractions);
+    return BEAR_OK;
+}
+
+double bear_solution_mean_charge(const bear_solution_t* solution)
+{
+    if(bear_solution_status(solution))
+        return 0.;
+    return solution->result.mean_charge();
+}
+
+int bear_solution_eval(const bear_solution_t* solution, double x, double* fractions)
+{
+    return bear_solution_eval_n(solution,&x,1,fractions);
+}
+
+int bear_solution_eval_n(const bear_solution_t* solution, const double* x, size_t n,
+                         double* fractions)
+{
+    if(bear_solution_status(solution) || (n>0 && (!x || !fractions)) || !solution->result.dynamic())
+        return BEAR_ERROR;
+    try
+    {
+        const size_t levels=solution->result.levels();
+        bear::bear_problem::vector_d F(levels);
+        for(size_t k(0); k<n; k++)
+        {
+            if(solution->result.eval(x[k],F))
+                return BEAR_ERROR;
+            std::copy(F.begin(),F.end(),fractions+k*levels);
+        }
+        return BEAR_OK;
+    }
+    catch(std::exception&)
+    {
+        return BEAR_ERROR;
+    }
+}
+
+size_t bear_solution_scan_size(const bear_solution_t* solution)
+{
+    if(bear_solution_status(solution))
+        return 0;
+    return solution->result.scan_size();
+}
+
+int bear_solution_scan_eval_n(const bear_solution_t* solution, const double* x, size_t n,
+                              double* fractions)
+{
+    if(bear_solution_status(solution) || (n>0 && (!x || !fractions)))
+        return BEAR_ERROR;
+    try
+    {
+        std::vector<bear::thickness_table<double> > tables;
+        if(solution->result.tabulate_scan(std::vector<double>(x,x+n),tables))
+            return BEAR_ERROR;
+        const size_t levels=solution->result.levels();
+        for(size_t j(0); j<tables.size(); j++)
+            if(n>0)
+                std::copy(tables[j].column(0),tables[j].column(0)+levels*n,fractions+j*n*levels);
+        return BEAR_OK;
+    }
+    catch(std::exception&)
+    {
+        return BEAR_ERROR;
+    }
+}
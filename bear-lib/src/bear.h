@@ -0,0 +1,115 @@
+/*
+ * File:   bear.h
+ *
+ * Created on October 17, 2026
+ */
+
+/*
+ * C API of libbear : charge state distributions of an ion beam through a target,
+ * from the cross-sections Q(i,j) of the transitions between its N charge states.
+ *
+ *   double factor;
+ *   bear_scale_factor("cm2","mug/cm2",12.,&factor);
+ *   bear_problem_t* problem=bear_problem_create(N,charge_min,Q,factor);
+ *   bear_problem_set_initial_condition(problem,F0);
+ *   bear_solution_t* solution=bear_problem_solve(problem);
+ *   if(bear_solution_status(solution)==BEAR_OK)
+ *       bear_solution_eval(solution,x,F);
+ *   bear_solution_destroy(solution);
+ *   bear_problem_destroy(problem);
+ *
+ * A problem or a solution can be read by several threads at once (all the
+ * functions taking a const pointer), and there is no global state : a solution
+ * stays valid after its problem is destroyed.
+ */
+
+#ifndef BEAR_H
+#define	BEAR_H
+
+#include <stddef.h>
+
+#if defined(__GNUC__)
+#define BEAR_API __attribute__((visibility("default")))
+#else
+#define BEAR_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* incremented when a function of this header changes */
+#define BEAR_API_VERSION 2
+
+/* return values */
+#define BEAR_OK     0
+#define BEAR_ERROR  1
+
+/* non-equilibrium solution */
+#define BEAR_DIAGONALIZATION    0   /* eigen decomposition, F(x) in closed form (default) */
+#define BEAR_PROPAGATOR         1   /* matrix exponential exp(Ax) */
+
+typedef struct bear_problem_s   bear_problem_t;
+typedef struct bear_solution_s  bear_solution_t;
+
+/* BEAR_API_VERSION of the library */
+BEAR_API int bear_api_version(void);
+
+/* factor from the cross-sections (e.g. "cm2", "mb") to the reaction probabilities per unit
+ * thickness (e.g. "mug/cm2", "mg/cm2") of a target of given mass number */
+BEAR_API int bear_scale_factor(const char* cross_section_unit, const char* thickness_unit,
+                               double target_mass_number, double* factor);
+
+/* problem of levels charge states charge_min, ..., charge_min+levels-1. cross_sections is
+ * the levels x levels row major matrix Q(i,j) = cross_sections[i*levels+j] of the
+ * transitions i -> j (the diagonal is ignored), multiplied by scale_factor.
+ * Return NULL if levels < 2 or cross_sections is NULL */
+BEAR_API bear_problem_t* bear_problem_create(size_t levels, int charge_min,
+                                             const double* cross_sections, double scale_factor);
+BEAR_API void bear_problem_destroy(bear_problem_t* problem);
+
+/* fractions F(x=0) of the levels (their sum must be 1), needed for F(x). NULL : equilibrium only */
+BEAR_API int bear_problem_set_initial_condition(bear_problem_t* problem, const double* fractions);
+
+/* parameter scan : K other initial fractions, fractions[j*levels+i] = F0_i of the scan j (each
+ * sum must be 1), solved with the same decomposition as the problem. NULL or K = 0 : no scan */
+BEAR_API int bear_problem_set_scan(bear_problem_t* problem, size_t K, const double* fractions);
+
+/* BEAR_DIAGONALIZATION or BEAR_PROPAGATOR */
+BEAR_API int bear_problem_set_method(bear_problem_t* problem, int method);
+
+/* solve the problem. Return NULL only if out of memory, check bear_solution_status */
+BEAR_API bear_solution_t* bear_problem_solve(const bear_problem_t* problem);
+BEAR_API void bear_solution_destroy(bear_solution_t* solution);
+
+/* BEAR_OK if solved, otherwise bear_solution_error tells why */
+BEAR_API int bear_solution_status(const bear_solution_t* solution);
+BEAR_API const char* bear_solution_error(const bear_solution_t* solution);
+
+/* number of levels N */
+BEAR_API size_t bear_solution_levels(const bear_solution_t* solution);
+
+/* equilibrium fractions (N values) and mean charge */
+BEAR_API int bear_solution_equilibrium(const bear_solution_t* solution, double* fractions);
+BEAR_API double bear_solution_mean_charge(const bear_solution_t* solution);
+
+/* F(x) (N values) at any thickness x, in the thickness unit of the scale factor */
+BEAR_API int bear_solution_eval(const bear_solution_t* solution, double x, double* fractions);
+
+/* F at n thicknesses : fractions[k*N+i] = F_i(x[k]) */
+BEAR_API int bear_solution_eval_n(const bear_solution_t* solution, const double* x, size_t n,
+                                  double* fractions);
+
+/* number K of initial conditions of the scan */
+BEAR_API size_t bear_solution_scan_size(const bear_solution_t* solution);
+
+/* F of all the scan at n increasing thicknesses, computed together :
+ * fractions[(j*n+k)*N+i] = F_i(x[k]) of the scan j */
+BEAR_API int bear_solution_scan_eval_n(const bear_solution_t* solution, const double* x, size_t n,
+                                       double* fractions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* BEAR_H */
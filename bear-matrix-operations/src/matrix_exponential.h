@@ -0,0 +1,91 @@
+/*
+ * File:   matrix_exponential.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef MATRIX_EXPONENTIAL_H
+#define	MATRIX_EXPONENTIAL_H
+
+// std
+#include <cmath>
+#include <cstddef>
+
+// boost
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+
+// bear
+#include "matrix_lu_solver.h"
+
+namespace bear
+{
+    namespace ublas = boost::numeric::ublas;
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    // E = exp(A) by scaling and squaring of the diagonal [q/q] Pade approximant
+    // (Golub & Van Loan, algorithm 11.3.1) : A is scaled by 2^-s so that
+    // ||A/2^s||_inf <= 1/2, then exp(A/2^s) ~ D^-1 N is squared s times.
+    // With q=6 the relative backward error is below 1e-15.
+    // M is a square (column major) ublas matrix, return 0 if ok, 1 otherwise.
+    template<typename M>
+    int expm(const M& A, M& E)
+    {
+        typedef typename M::value_type value_type;
+
+        const std::size_t dim=A.size1();
+        if(dim!=A.size2())
+            return 1;
+
+        E.resize(dim,dim,false);
+        if(dim==0)
+            return 0;
+
+        // scaling
+        value_type norm=ublas::norm_inf(A);
+        int s=0;
+        if(norm>0.5)
+            s=static_cast<int>(std::ceil(std::log2(norm/0.5)));
+        M X=A*std::ldexp(value_type(1),-s);
+
+        // Pade approximant : N = sum c_k X^k, D = sum (-1)^k c_k X^k
+        const int q=6;
+        value_type c=1.;
+        ublas::identity_matrix<value_type> Id(dim);
+        M N=Id;
+        M D=Id;
+        M Xk=Id;
+        M temp(dim,dim);
+        for(int k(1); k<=q; k++)
+        {
+            c*=value_type(q-k+1)/value_type(k*(2*q-k+1));
+            ublas::noalias(temp)=ublas::prod(X,Xk);
+            Xk.swap(temp);
+            N+=c*Xk;
+            if(k%2==0)
+                D+=c*Xk;
+            else
+                D-=c*Xk;
+        }
+
+        // exp(X) ~ D^-1 N
+        lu_solver<M> lu;
+        if(lu.factorize(D))
+            return 1;
+        E=N;
+        if(lu.solve(E))
+            return 1;
+
+        // squaring
+        for(int k(0); k<s; k++)
+        {
+            ublas::noalias(temp)=ublas::prod(E,E);
+            E.swap(temp);
+        }
+
+        return 0;
+    }
+
+} // bear namespace
+
+#endif	/* MATRIX_EXPONENTIAL_H */
@@ -0,0 +1,129 @@
+/*
+ * File:   matrix_lu_solver.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef MATRIX_LU_SOLVER_H
+#define	MATRIX_LU_SOLVER_H
+
+// std
+#include <cstddef>
+
+// boost
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+
+// bindings
+#ifdef HAS_LAPACK_BINDINGS
+#include "boost/numeric/bindings/lapack/gesv.hpp"
+#include "boost/numeric/bindings/traits/ublas_matrix.hpp"
+#include "boost/numeric/bindings/traits/ublas_vector.hpp"
+#endif
+
+namespace bear
+{
+    namespace ublas = boost::numeric::ublas;
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    // LU factorization PA=LU of a square matrix A, kept to solve AX=B for any
+    // number of right hand sides in O(N^2) each, instead of forming A^-1.
+    // Uses lapack getrf/getrs if the bindings are available (A must then be
+    // column major), and ublas lu_factorize/lu_substitute otherwise.
+    template<typename M>
+    class lu_solver
+    {
+        typedef typename M::value_type                                  value_type;
+        typedef ublas::vector<value_type>                                 vector_d;
+        typedef ublas::matrix<value_type,ublas::column_major>             matrix_d;
+
+    public:
+        lu_solver() : fLU(), fPivots(0), fFactorized(false) {}
+        virtual ~lu_solver(){}
+
+        // return 0 if ok, 1 if A is not square or singular
+        int factorize(const M& A)
+        {
+            fFactorized=false;
+            if(A.size1()!=A.size2() || A.size1()==0)
+                return 1;
+
+            fLU=A;
+#ifdef HAS_LAPACK_BINDINGS
+            fPivots.resize(fLU.size1(),false);
+            int info=boost::numeric::bindings::lapack::getrf(fLU,fPivots);
+            if(info!=0)
+                return 1;
+#else
+            fPivots=pivots_type(fLU.size1());
+            if(ublas::lu_factorize(fLU,fPivots)!=0)
+                return 1;
+#endif
+            fFactorized=true;
+            return 0;
+        }
+
+        // solve Ax=b
+        int solve(const vector_d& b, vector_d& x) const
+        {
+            if(!fFactorized || b.size()!=fLU.size1())
+                return 1;
+#ifdef HAS_LAPACK_BINDINGS
+            matrix_d B(b.size(),1);
+            ublas::column(B,0)=b;
+            if(solve(B))
+                return 1;
+            x=ublas::column(B,0);
+#else
+            x=b;
+            ublas::lu_substitute(fLU,fPivots,x);
+#endif
+            return 0;
+        }
+
+        // solve AX=B in place, one right hand side per column of B
+        int solve(matrix_d& B) const
+        {
+            if(!fFactorized || B.size1()!=fLU.size1())
+                return 1;
+#ifdef HAS_LAPACK_BINDINGS
+            int info=boost::numeric::bindings::lapack::getrs('N',fLU,fPivots,B);
+            if(info!=0)
+                return 1;
+#else
+            ublas::lu_substitute(fLU,fPivots,B);
+#endif
+            return 0;
+        }
+
+        bool factorized() const
+        {
+            return fFactorized;
+        }
+
+        std::size_t size() const
+        {
+            return fFactorized ? fLU.size1() : 0;
+        }
+
+        void clear()
+        {
+            fLU.clear();
+            fFactorized=false;
+        }
+
+    private:
+#ifdef HAS_LAPACK_BINDINGS
+        typedef ublas::vector<int>                                     pivots_type;
+#else
+        typedef ublas::permutation_matrix<std::size_t>                 pivots_type;
+#endif
+        M fLU;                  // L and U factors
+        pivots_type fPivots;    // row permutation P
+        bool fFactorized;
+    };
+
+} // bear namespace
+
+#endif	/* MATRIX_LU_SOLVER_H */
@@ -14,6 +14,7 @@
 #include <boost/numeric/ublas/io.hpp>
 
 #include "def.h"
+#include "bear_numeric_solution.h"
 
 namespace bear
 {
@@ -35,12 +36,14 @@ namespace bear
         double fPRECISON;
         std::shared_ptr<bear_summary> fSummary;
     protected:
-        std::map<std::size_t, std::string> fGeneral_solution;
+        bear_numeric_solution<T> fGeneral_solution;
+        std::map<std::size_t, std::string> fAnalytic_formulae;
         double fUnit_convertor=1.;
         
     public:
         bear_analytic_solution() :  fPRECISON(1.e-15),
                                     fGeneral_solution(),
+                                    fAnalytic_formulae(),
                                     fUnit_convertor(1.)
         {}
         virtual ~bear_analytic_solution(){}
@@ -49,9 +52,9 @@ namespace bear
         int init(const matrix_c& eigen_mat)
         {
             fPRECISON=1.e-15; // temporary, need a real error treatment
-            for(size_t row; row<eigen_mat.size1(); row++)
+            for(size_t row(0); row<eigen_mat.size1(); row++)
             {
-                fGeneral_solution[row]="";
+                fAnalytic_formulae[row]="";
             }
             
             return 0;
@@ -62,10 +65,21 @@ namespace bear
             fSummary = summary;
             return 0;
         }
+        // numeric solution, evaluated directly by the consumers (table, plot, ...)
+        int form_numeric_solution(  const matrix_d& P_R, 
+                                    const vector_d& unknown_coef, 
+                                    const eigen_value_map& eig_val_map, 
+                                    const complex_eigen_values& eig_val_c,
+                                    const vector_d& particular_solution)
+        {
+            return fGeneral_solution.init(P_R,unknown_coef,eig_val_map,eig_val_c,particular_solution,fUnit_convertor);
+        }
+        
+        // string formulae, only needed to save the analytic solution to file
         int form_general_solution(const vector_d& particular_solution )
         {
             
-            for(auto& p : fGeneral_solution)
+            for(auto& p : fAnalytic_formulae)
             {
                 p.second+="+";
                 p.second+=to_string_scientific(particular_solution(p.first));
@@ -75,20 +89,20 @@ namespace bear
             
             std::size_t last_key=0;
             std::size_t first_key=0;
-            if( !fGeneral_solution.empty() )
+            if( !fAnalytic_formulae.empty() )
             {
-                first_key=fGeneral_solution.begin()->first;
-                last_key=fGeneral_solution.rbegin()->first;
+                first_key=fAnalytic_formulae.begin()->first;
+                last_key=fAnalytic_formulae.rbegin()->first;
             }
             
             last_key+=1;// because store keys as 0, 1 ... N-2
             // 8 lvl system -> 0, 1, ... 6, and we print 1, ... 7
             // need to add the last eq F8= 1 - sum of the other states
             
-            if(last_key!=0 && !fGeneral_solution.count(last_key))
+            if(last_key!=0 && !fAnalytic_formulae.count(last_key))
             {
                 std::string F_last("1. - (");
-                for(const auto& p : fGeneral_solution)
+                for(const auto& p : fAnalytic_formulae)
                 {
                     if(p.first != first_key)
                     F_last+=" + ";
@@ -96,11 +110,11 @@ namespace bear
                     
                 }
                     F_last+=")";
-                fGeneral_solution[last_key]=F_last;
+                fAnalytic_formulae[last_key]=F_last;
             }
             
             // Copy final solution
-            fSummary->analytical_solutions=fGeneral_solution;
+            fSummary->analytical_solutions=fAnalytic_formulae;
             
             
             
@@ -111,8 +125,8 @@ namespace bear
         
         int form_homogeneous_solution(  const matrix_c& eigen_mat, 
                                         const vector_d& unknown_coef, 
-                                        eigen_value_map& eig_val_map, 
-                                        complex_eigen_values& eig_val_c)
+                                        const eigen_value_map& eig_val_map, 
+                                        const complex_eigen_values& eig_val_c)
         {
             
             
@@ -206,32 +220,32 @@ namespace bear
                     // 
                     if(std::fabs(C1_val)>fPRECISON)                                                     //                  [if C1!=0]
                     {
-                        if(!fGeneral_solution[row].empty())                             
-                            fGeneral_solution[row]+="+";                                    // +                [if string not empty]
+                        if(!fAnalytic_formulae[row].empty())                             
+                            fAnalytic_formulae[row]+="+";                                    // +                [if string not empty]
 
-                        //fGeneral_solution[row]+="(";                                        // (                [if C1!=0]
-                        //fGeneral_solution[row]+=C1;                                         // C1               [if C1!=0]
-                        //fGeneral_solution[row]+=")";                                        // )                [if C1!=0]
-                        //fGeneral_solution[row]+="*";                                        // *                [if C1!=0]
+                        //fAnalytic_formulae[row]+="(";                                        // (                [if C1!=0]
+                        //fAnalytic_formulae[row]+=C1;                                         // C1               [if C1!=0]
+                        //fAnalytic_formulae[row]+=")";                                        // )                [if C1!=0]
+                        //fAnalytic_formulae[row]+="*";                                        // *                [if C1!=0]
                         
                         if(std::fabs(lambda)>fPRECISON)
-                            fGeneral_solution[row]+= expLambdaX + "*";                      // exp(lambda x) *  [if C1!=0] [if lambda!=0]
+                            fAnalytic_formulae[row]+= expLambdaX + "*";                      // exp(lambda x) *  [if C1!=0] [if lambda!=0]
                         // component of first eigenvector
-                        fGeneral_solution[row]+="(";                                        // (
+                        fAnalytic_formulae[row]+="(";                                        // (
                         if(std::fabs(ai_val)>fPRECISON)
-                            fGeneral_solution[row]+="(" + C1xai + ")";                         // (ai)             [if C1!=0] [if ai!=0]
+                            fAnalytic_formulae[row]+="(" + C1xai + ")";                         // (ai)             [if C1!=0] [if ai!=0]
                         if(std::fabs(omega)>fPRECISON)
                         {
                             if(std::fabs(ai_val)>fPRECISON)
-                                fGeneral_solution[row]+="*"+coswx;                          // * cos(omega x)   [if C1!=0] [if omega!=0] [if ai!=0]
+                                fAnalytic_formulae[row]+="*"+coswx;                          // * cos(omega x)   [if C1!=0] [if omega!=0] [if ai!=0]
                             if(std::fabs(bi_val)>fPRECISON)
                             {
-                                fGeneral_solution[row]+="-1.*";                                // -                [if C1!=0] [if omega!=0] [if bi!=0]
-                                fGeneral_solution[row]+="(" + C1xbi + ")";                     // (bi)             [if C1!=0] [if omega!=0] [if bi!=0]
-                                fGeneral_solution[row]+="*"+sinwx;                          // * sin(omega x)   [if C1!=0] [if omega!=0] [if bi!=0]
+                                fAnalytic_formulae[row]+="-1.*";                                // -                [if C1!=0] [if omega!=0] [if bi!=0]
+                                fAnalytic_formulae[row]+="(" + C1xbi + ")";                     // (bi)             [if C1!=0] [if omega!=0] [if bi!=0]
+                                fAnalytic_formulae[row]+="*"+sinwx;                          // * sin(omega x)   [if C1!=0] [if omega!=0] [if bi!=0]
                             }
                         }
-                        fGeneral_solution[row]+=")";                                        // )
+                        fAnalytic_formulae[row]+=")";                                        // )
                     }
                     // ///////////////////////////////
                     // contribution from eigenvector' complex conjugate :
@@ -239,32 +253,32 @@ namespace bear
                     
                     if(std::fabs(C2_val)>fPRECISON)                                                     //                  [if C2!=0]
                     {
-                        if(!fGeneral_solution[row].empty()) 
-                            fGeneral_solution[row]+="+";                                    // +                [if string not empty]
+                        if(!fAnalytic_formulae[row].empty()) 
+                            fAnalytic_formulae[row]+="+";                                    // +                [if string not empty]
 
-                        //fGeneral_solution[row]+="(";                                        // (                [if C2!=0]
-                        //fGeneral_solution[row]+=C2;                                         // C2               [if C2!=0]
-                        //fGeneral_solution[row]+=")";                                        // )                [if C2!=0]
-                        //fGeneral_solution[row]+="*";                                        // *                [if C2!=0]
+                        //fAnalytic_formulae[row]+="(";                                        // (                [if C2!=0]
+                        //fAnalytic_formulae[row]+=C2;                                         // C2               [if C2!=0]
+                        //fAnalytic_formulae[row]+=")";                                        // )                [if C2!=0]
+                        //fAnalytic_formulae[row]+="*";                                        // *                [if C2!=0]
                         
                         if(std::fabs(lambda)>fPRECISON)
-                            fGeneral_solution[row]+= expLambdaX + "*";                      // exp(lambda x) *  [if C2!=0] [if lambda!=0]
+                            fAnalytic_formulae[row]+= expLambdaX + "*";                      // exp(lambda x) *  [if C2!=0] [if lambda!=0]
                         // component of first eigenvector
-                        fGeneral_solution[row]+="(";                                        // (
+                        fAnalytic_formulae[row]+="(";                                        // (
                         if(std::fabs(bi_val)>fPRECISON)
-                            fGeneral_solution[row]+="(" + C2xbi + ")";                         // (bi)             [if C2!=0] [if bi!=0]
+                            fAnalytic_formulae[row]+="(" + C2xbi + ")";                         // (bi)             [if C2!=0] [if bi!=0]
                         if(std::fabs(omega)>fPRECISON)
                         {
                             if(std::fabs(bi_val)>fPRECISON)
-                                fGeneral_solution[row]+="*"+coswx;                          // * cos(omega x)   [if C2!=0] [if omega!=0] [if bi!=0]
+                                fAnalytic_formulae[row]+="*"+coswx;                          // * cos(omega x)   [if C2!=0] [if omega!=0] [if bi!=0]
                             if(std::fabs(ai_val)>fPRECISON)
                             {
-                                fGeneral_solution[row]+="+1.*";                                // -                [if C2!=0] [if omega!=0] [if ai!=0]
-                                fGeneral_solution[row]+="(" + C2xai + ")";                     // (ai)             [if C2!=0] [if omega!=0] [if ai!=0]
-                                fGeneral_solution[row]+="*"+sinwx;                          // * sin(omega x)   [if C2!=0] [if omega!=0] [if ai!=0]
+                                fAnalytic_formulae[row]+="+1.*";                                // -                [if C2!=0] [if omega!=0] [if ai!=0]
+                                fAnalytic_formulae[row]+="(" + C2xai + ")";                     // (ai)             [if C2!=0] [if omega!=0] [if ai!=0]
+                                fAnalytic_formulae[row]+="*"+sinwx;                          // * sin(omega x)   [if C2!=0] [if omega!=0] [if ai!=0]
                             }
                         }
-                        fGeneral_solution[row]+=")";                                        // )
+                        fAnalytic_formulae[row]+=")";                                        // )
                     }
                     
                     
@@ -309,21 +323,21 @@ namespace bear
                     
                     if(std::fabs(C1_val)>fPRECISON && std::fabs(ai_val)>fPRECISON)
                     {
-                        if(!fGeneral_solution[row].empty())
-                            fGeneral_solution[row]+="+";
+                        if(!fAnalytic_formulae[row].empty())
+                            fAnalytic_formulae[row]+="+";
 
                         
-                        fGeneral_solution[row]+="(" + C1ai +")";                                             // C1
-                        //fGeneral_solution[row]+="* ";                                           // * 
+                        fAnalytic_formulae[row]+="(" + C1ai +")";                                             // C1
+                        //fAnalytic_formulae[row]+="* ";                                           // * 
                         if(std::fabs(lambda)>fPRECISON)
-                            fGeneral_solution[row]+= "*" + expLambdaX;                          // exp(lambda x) *   [if lambda!=0]
-                        //fGeneral_solution[row]+=ai;                                             // ai
+                            fAnalytic_formulae[row]+= "*" + expLambdaX;                          // exp(lambda x) *   [if lambda!=0]
+                        //fAnalytic_formulae[row]+=ai;                                             // ai
                     }
                 }
             }
             
             
-            /*for(const auto& p : fGeneral_solution)
+            /*for(const auto& p : fAnalytic_formulae)
             {
                 LOG(INFO)<<"F"<< p.first+1 <<"(x) = "<< p.second;
             }*/
@@ -403,48 +417,48 @@ namespace bear
                     
                     // 
                     
-                    if(!fGeneral_solution[row].empty())                             
-                        fGeneral_solution[row]+="+";                                    // +                [if string not empty]
+                    if(!fAnalytic_formulae[row].empty())                             
+                        fAnalytic_formulae[row]+="+";                                    // +                [if string not empty]
 
-                    //fGeneral_solution[row]+="(";                                        // (                [if C1!=0]
-                    //fGeneral_solution[row]+=C1;                                         // C1               [if C1!=0]
-                    //fGeneral_solution[row]+=")";                                        // )                [if C1!=0]
-                    //fGeneral_solution[row]+="*";                                        // *                [if C1!=0]
+                    //fAnalytic_formulae[row]+="(";                                        // (                [if C1!=0]
+                    //fAnalytic_formulae[row]+=C1;                                         // C1               [if C1!=0]
+                    //fAnalytic_formulae[row]+=")";                                        // )                [if C1!=0]
+                    //fAnalytic_formulae[row]+="*";                                        // *                [if C1!=0]
 
-                    fGeneral_solution[row]+= expLambdaX + "*";                      // exp(lambda x) *  [if C1!=0] [if lambda!=0]
+                    fAnalytic_formulae[row]+= expLambdaX + "*";                      // exp(lambda x) *  [if C1!=0] [if lambda!=0]
                     // component of first eigenvector
-                    fGeneral_solution[row]+="(";                                        // (
-                    fGeneral_solution[row]+="(" + C1xai + ")";                         // (ai)             [if C1!=0] [if ai!=0]
+                    fAnalytic_formulae[row]+="(";                                        // (
+                    fAnalytic_formulae[row]+="(" + C1xai + ")";                         // (ai)             [if C1!=0] [if ai!=0]
                     
-                    fGeneral_solution[row]+="*"+coswx;                          // * cos(omega x)   [if C1!=0] [if omega!=0] [if ai!=0]
-                    fGeneral_solution[row]+="-";                                // -                [if C1!=0] [if omega!=0] [if bi!=0]
-                    fGeneral_solution[row]+="(" + C1xbi + ")";                     // (bi)             [if C1!=0] [if omega!=0] [if bi!=0]
-                    fGeneral_solution[row]+="*"+sinwx;                          // * sin(omega x)   [if C1!=0] [if omega!=0] [if bi!=0]
-                    fGeneral_solution[row]+=")";                                        // )
+                    fAnalytic_formulae[row]+="*"+coswx;                          // * cos(omega x)   [if C1!=0] [if omega!=0] [if ai!=0]
+                    fAnalytic_formulae[row]+="-";                                // -                [if C1!=0] [if omega!=0] [if bi!=0]
+                    fAnalytic_formulae[row]+="(" + C1xbi + ")";                     // (bi)             [if C1!=0] [if omega!=0] [if bi!=0]
+                    fAnalytic_formulae[row]+="*"+sinwx;                          // * sin(omega x)   [if C1!=0] [if omega!=0] [if bi!=0]
+                    fAnalytic_formulae[row]+=")";                                        // )
                     
                     // ///////////////////////////////
                     // contribution from eigenvector' complex conjugate :
                     // coef of first eigenvector
                     
-                    if(!fGeneral_solution[row].empty()) 
-                        fGeneral_solution[row]+="+";                                    // +                [if string not empty]
+                    if(!fAnalytic_formulae[row].empty()) 
+                        fAnalytic_formulae[row]+="+";                                    // +                [if string not empty]
 
-                    //fGeneral_solution[row]+="(";                                        // (                [if C2!=0]
-                    //fGeneral_solution[row]+=C2;                                         // C2               [if C2!=0]
-                    //fGeneral_solution[row]+=")";                                        // )                [if C2!=0]
-                    //fGeneral_solution[row]+="*";                                        // *                [if C2!=0]
+                    //fAnalytic_formulae[row]+="(";                                        // (                [if C2!=0]
+                    //fAnalytic_formulae[row]+=C2;                                         // C2               [if C2!=0]
+                    //fAnalytic_formulae[row]+=")";                                        // )                [if C2!=0]
+                    //fAnalytic_formulae[row]+="*";                                        // *                [if C2!=0]
 
-                    fGeneral_solution[row]+= expLambdaX + "*";                      // exp(lambda x) *  [if C2!=0] [if lambda!=0]
+                    fAnalytic_formulae[row]+= expLambdaX + "*";                      // exp(lambda x) *  [if C2!=0] [if lambda!=0]
                     // component of first eigenvector
-                    fGeneral_solution[row]+="(";                                        // (
-                    fGeneral_solution[row]+="(" + C2xbi + ")";                         // (bi)             [if C2!=0] [if bi!=0]
+                    fAnalytic_formulae[row]+="(";                                        // (
+                    fAnalytic_formulae[row]+="(" + C2xbi + ")";                         // (bi)             [if C2!=0] [if bi!=0]
                     
-                    fGeneral_solution[row]+="*"+coswx;                          // * cos(omega x)   [if C2!=0] [if omega!=0] [if bi!=0]
+                    fAnalytic_formulae[row]+="*"+coswx;                          // * cos(omega x)   [if C2!=0] [if omega!=0] [if bi!=0]
 
-                    fGeneral_solution[row]+="+";                                // -                [if C2!=0] [if omega!=0] [if ai!=0]
-                    fGeneral_solution[row]+="(" + C2xai + ")";                     // (ai)             [if C2!=0] [if omega!=0] [if ai!=0]
-                    fGeneral_solution[row]+="*"+sinwx;                          // * sin(omega x)   [if C2!=0] [if omega!=0] [if ai!=0]
-                    fGeneral_solution[row]+=")";                                        // )
+                    fAnalytic_formulae[row]+="+";                                // -                [if C2!=0] [if omega!=0] [if ai!=0]
+                    fAnalytic_formulae[row]+="(" + C2xai + ")";                     // (ai)             [if C2!=0] [if omega!=0] [if ai!=0]
+                    fAnalytic_formulae[row]+="*"+sinwx;                          // * sin(omega x)   [if C2!=0] [if omega!=0] [if ai!=0]
+                    fAnalytic_formulae[row]+=")";                                        // )
                     
                     
                 }
@@ -477,19 +491,19 @@ namespace bear
                     C1=to_string_scientific(C1_val);
                     C1ai=to_string_scientific(C1ai_val);
                     
-                    if(!fGeneral_solution[row].empty())
-                        fGeneral_solution[row]+="+";
+                    if(!fAnalytic_formulae[row].empty())
+                        fAnalytic_formulae[row]+="+";
 
 
-                    fGeneral_solution[row]+="(" + C1ai +")";                                             // C1
-                    //fGeneral_solution[row]+="* ";                                           // * 
-                    fGeneral_solution[row]+= "*" + expLambdaX;                          // exp(lambda x) *   [if lambda!=0]
-                    //fGeneral_solution[row]+=ai;                                             // ai
+                    fAnalytic_formulae[row]+="(" + C1ai +")";                                             // C1
+                    //fAnalytic_formulae[row]+="* ";                                           // * 
+                    fAnalytic_formulae[row]+= "*" + expLambdaX;                          // exp(lambda x) *   [if lambda!=0]
+                    //fAnalytic_formulae[row]+=ai;                                             // ai
                 }
             }
             
             
-            for(const auto& p : fGeneral_solution)
+            for(const auto& p : fAnalytic_formulae)
             {
                 LOG(INFO)<<"F"<< p.first+1 <<"(x) = "<< p.second;
             }
@@ -0,0 +1,859 @@
+/*
+ * File:   bear_core.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BEAR_CORE_H
+#define	BEAR_CORE_H
+
+#include <map>
+#include <cmath>
+#include <tuple>
+#include <vector>
+#include <string>
+#include <complex>
+#include <utility>
+#include <algorithm>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "def.h"
+#include "matrix_lu_solver.h"
+#include "matrix_exponential.h"
+#include "matrix_diagonalization.h"
+#include "bear_numeric_solution.h"
+#include "bear_propagator.h"
+#include "thickness_table.h"
+#include "thickness_sampler.h"
+#include "bear_problem.h"
+#include "bear_system.h"
+
+namespace bear
+{
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// move the complex conjugate pairs of eigenvalues from map to comp_ev_container //
+    /// as (index, index_bar, lambda(index)) with index < index_bar, sorted by index. //
+    /// The complex eigenvalues are sorted by real part, and each one is matched     //
+    /// with the first unmatched eigenvalue of opposite imaginary part such that     //
+    /// |lambda - conj(lambda_bar)| <= rel_tol * max|lambda|, searched among the     //
+    /// following eigenvalues whose real parts are within this tolerance. The       //
+    /// complex eigenvalues left without partner are returned in unmatched.         //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline void pair_complex_conjugates(std::map<size_t, std::complex<double> >& map,
+                                    std::vector<std::tuple<size_t,size_t,std::complex<double> > >& comp_ev_container,
+                                    std::vector<std::pair<size_t,std::complex<double> > >& unmatched,
+                                    double rel_tol=1.e-10)
+    {
+        typedef std::pair<size_t,std::complex<double> > eigen_value;
+        std::vector<eigen_value> complex_ev;
+        double scale=0.;
+        for(const auto& p : map)
+        {
+            scale=std::max(scale,std::abs(p.second));
+            if(p.second.imag()!=0)
+                complex_ev.push_back(p);
+        }
+        const double tol=rel_tol*scale;
+
+        std::sort(complex_ev.begin(),complex_ev.end(),
+                [](const eigen_value& a, const eigen_value& b)
+                {
+                    if(a.second.real()!=b.second.real())
+                        return a.second.real()<b.second.real();
+                    if(std::abs(a.second.imag())!=std::abs(b.second.imag()))
+                        return std::abs(a.second.imag())<std::abs(b.second.imag());
+                    return a.first<b.first;
+                });
+
+        std::vector<bool> matched(complex_ev.size(),false);
+        const size_t first_pair=comp_ev_container.size();
+        for(size_t i(0); i<complex_ev.size(); i++)
+        {
+            if(matched[i])
+                continue;
+            const std::complex<double>& lambda=complex_ev[i].second;
+            for(size_t j(i+1); j<complex_ev.size() && complex_ev[j].second.real()-lambda.real()<=tol; j++)
+            {
+                const std::complex<double>& lambda_bar=complex_ev[j].second;
+                if(matched[j] || (lambda.imag()>0)==(lambda_bar.imag()>0) || std::abs(lambda-std::conj(lambda_bar))>tol)
+                    continue;
+                matched[i]=matched[j]=true;
+                size_t index=std::min(complex_ev[i].first,complex_ev[j].first);
+                size_t index_bar=std::max(complex_ev[i].first,complex_ev[j].first);
+                comp_ev_container.push_back(std::make_tuple(index,index_bar,map.at(index)));
+                map.erase(index);
+                map.erase(index_bar);
+                break;
+            }
+        }
+        std::sort(comp_ev_container.begin()+first_pair,comp_ev_container.end(),
+                [](const std::tuple<size_t,size_t,std::complex<double> >& a,
+                   const std::tuple<size_t,size_t,std::complex<double> >& b)
+                {
+                    return std::get<0>(a)<std::get<0>(b);
+                });
+
+        unmatched.clear();
+        for(size_t i(0); i<complex_ev.size(); i++)
+            if(!matched[i])
+                unmatched.push_back(complex_ev[i]);
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// real eigenbasis P_R of the eigenvectors P : a complex pair (k,k') gives the  //
+    /// columns Re(v_k) and Im(v_k), a real eigenvalue the column Re(v_k)            //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    void real_eigenbasis(   const ublas::matrix<std::complex<T>,ublas::column_major>& P,
+                            const std::map<size_t, std::complex<T> >& ev_map,
+                            const std::vector<std::tuple<size_t,size_t,std::complex<double> > >& complex_conjugates,
+                            ublas::matrix<T,ublas::column_major>& P_R)
+    {
+        size_t dim = 2*complex_conjugates.size() + ev_map.size();
+        P_R.resize(dim,dim,false);
+        for(const auto& p : complex_conjugates)
+        {
+            size_t index=0;
+            size_t index_bar=0;
+            std::tie(index,index_bar,std::ignore) = p;
+            for(size_t i(0); i<P.size1(); i++)
+            {
+                P_R(i,index)     = P(i,index).real();
+                P_R(i,index_bar) = P(i,index).imag();
+            }
+        }
+        for(const auto& p : ev_map)
+            for(size_t i(0); i<P.size1(); i++)
+                P_R(i,p.first) = P(i,p.first).real();
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// integration constants of vec = Sum_j c_j v_j in the real eigenbasis P_R :   //
+    /// the left eigenvectors u_j (u_j^H A = lambda_j u_j^H, columns of U) are      //
+    /// orthogonal to the v_k with k != j, thus c_j = u_j^H vec / u_j^H v_j. In the //
+    /// real basis, a complex pair contributes c v + conj(c v)                      //
+    /// = 2 Re(c) Re(v) - 2 Im(c) Im(v).                                            //
+    /// return 1 if a left and right eigenvector are orthogonal (defective matrix)  //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    int project_on_left_eigenvectors(   const ublas::matrix<std::complex<T>,ublas::column_major>& P,
+                                        const ublas::matrix<std::complex<T>,ublas::column_major>& U,
+                                        const std::map<size_t, std::complex<T> >& ev_map,
+                                        const std::vector<std::tuple<size_t,size_t,std::complex<double> > >& complex_conjugates,
+                                        const ublas::vector<T>& vec, ublas::vector<T>& coef)
+    {
+        auto constant=[&](size_t j, std::complex<T>& c) -> int
+        {
+            std::complex<T> uv=0.;
+            std::complex<T> ud=0.;
+            for(size_t i(0); i<vec.size(); i++)
+            {
+                std::complex<T> u_bar=std::conj(U(i,j));
+                uv+=u_bar*P(i,j);
+                ud+=u_bar*vec(i);
+            }
+            if(std::abs(uv)==0.)
+                return 1;
+            c=ud/uv;
+            return 0;
+        };
+
+        coef.resize(vec.size(),false);
+        std::complex<T> c;
+        for(const auto& p : complex_conjugates)
+        {
+            size_t index=0;
+            size_t index_bar=0;
+            std::tie(index,index_bar,std::ignore) = p;
+            if(constant(index,c))
+                return 1;
+            coef(index)     =  2.*c.real();
+            coef(index_bar) = -2.*c.imag();
+        }
+        for(const auto& p : ev_map)
+        {
+            if(constant(p.first,c))
+                return 1;
+            coef(p.first)=c.real();
+        }
+        return 0;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// real matrix L of the same projection, coef = L vec, for the parameter scans: //
+    /// the integration constants of K vectors (columns of a matrix) are then one   //
+    /// matrix product. With w_j = conj(u_j) / u_j^H v_j, the row of a real mode is //
+    /// Re(w_j), and the rows of a complex pair 2 Re(w_k) and -2 Im(w_k).           //
+    /// return 1 if a left and right eigenvector are orthogonal (defective matrix)  //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    int left_projection(const ublas::matrix<std::complex<T>,ublas::column_major>& P,
+                        const ublas::matrix<std::complex<T>,ublas::column_major>& U,
+                        const std::map<size_t, std::complex<T> >& ev_map,
+                        const std::vector<std::tuple<size_t,size_t,std::complex<double> > >& complex_conjugates,
+                        ublas::matrix<T,ublas::column_major>& L)
+    {
+        const size_t dim=P.size1();
+        auto left_vector=[&](size_t j, std::vector<std::complex<T> >& w) -> int
+        {
+            std::complex<T> uv=0.;
+            for(size_t i(0); i<dim; i++)
+                uv+=std::conj(U(i,j))*P(i,j);
+            if(std::abs(uv)==0.)
+                return 1;
+            w.resize(dim);
+            for(size_t i(0); i<dim; i++)
+                w[i]=std::conj(U(i,j))/uv;
+            return 0;
+        };
+
+        L.resize(dim,dim,false);
+        std::vector<std::complex<T> > w;
+        for(const auto& p : complex_conjugates)
+        {
+            size_t index=0;
+            size_t index_bar=0;
+            std::tie(index,index_bar,std::ignore) = p;
+            if(left_vector(index,w))
+                return 1;
+            for(size_t i(0); i<dim; i++)
+            {
+                L(index,i)     =  2.*w[i].real();
+                L(index_bar,i) = -2.*w[i].imag();
+            }
+        }
+        for(const auto& p : ev_map)
+        {
+            if(left_vector(p.first,w))
+                return 1;
+            for(size_t i(0); i<dim; i++)
+                L(p.first,i)=w[i].real();
+        }
+        return 0;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// eigen decomposition A = P D P^-1 of the reduced system (dim N-1), shared by  //
+    /// bear_solve and the solve_bear_equations policy. The complex eigenvalues are  //
+    /// paired (pair_complex_conjugates) and the real eigenbasis P_R is formed when  //
+    /// A is diagonalizable. Otherwise the solution needs the propagator exp(Ax) :   //
+    ///   - lapack returns P = Id if A is not diagonalizable                        //
+    ///   - a complex eigenvalue without conjugate has no real mode                 //
+    /// A null spectrum (all eigenvalues zero) has no decomposition method.         //
+    /// //////////////////////////////////////////////////////////////////////////////
+    enum class decomposition_case
+    {
+        diagonalizable,
+        not_diagonalizable,
+        unpaired_eigenvalues,
+        null_spectrum
+    };
+
+    struct eigen_decomposition
+    {
+        typedef ublas::vector<std::complex<double> >                         vector_c;
+        typedef ublas::matrix<std::complex<double>,ublas::column_major>      matrix_c;
+        typedef ublas::matrix<double,ublas::column_major>                    matrix_d;
+
+        eigen_decomposition() : diagonalization(decomposition_case::null_spectrum), D(), P(), P_inv(),
+                                ev_map(), complex_conjugates(), unmatched(), P_R()
+        {}
+
+        decomposition_case diagonalization;
+        vector_c D;                     // eigenvalues
+        matrix_c P;                     // right eigenvectors (columns)
+        matrix_c P_inv;                 // left eigenvectors (columns, rows of P^-1 up to a normalization)
+        std::map<size_t, std::complex<double> > ev_map;                                  // real eigenvalues
+        std::vector<std::tuple<size_t,size_t,std::complex<double> > > complex_conjugates; // paired ones
+        std::vector<std::pair<size_t,std::complex<double> > > unmatched;                 // unpaired ones
+        matrix_d P_R;                   // real eigenbasis
+    };
+
+    // return the error code of lapack (0 if the decomposition was computed)
+    inline int decompose(const ublas::matrix<double,ublas::column_major>& A, eigen_decomposition& decomposition)
+    {
+        const size_t dim=A.size1();
+        eigen_decomposition::matrix_d A_copy=A;     // overwritten by lapack
+        decomposition=eigen_decomposition();
+        decomposition.D.resize(dim);
+        decomposition.P.resize(dim,dim);
+        decomposition.P_inv.resize(dim,dim);
+        int error=diagonalize_gen(A_copy,decomposition.D,&decomposition.P_inv,&decomposition.P);
+        if(error)
+            return error;
+
+        bool identity=true;
+        for(size_t j(0); j<dim && identity; j++)
+            for(size_t i(0); i<dim && identity; i++)
+                if(decomposition.P(i,j)!=std::complex<double>(i==j ? 1. : 0.,0.))
+                    identity=false;
+        if(identity)
+        {
+            decomposition.diagonalization=decomposition_case::not_diagonalizable;
+            return 0;
+        }
+
+        bool null_spectrum=true;
+        for(const auto& eigen_value : decomposition.D)
+            if(eigen_value!=std::complex<double>(0.,0.))
+                null_spectrum=false;
+        if(null_spectrum)
+        {
+            decomposition.diagonalization=decomposition_case::null_spectrum;
+            return 0;
+        }
+
+        for(size_t i(0); i<dim; i++)
+            decomposition.ev_map.insert(std::make_pair(i,decomposition.D(i)));
+        pair_complex_conjugates(decomposition.ev_map,decomposition.complex_conjugates,decomposition.unmatched);
+        if(!decomposition.unmatched.empty())
+        {
+            decomposition.diagonalization=decomposition_case::unpaired_eigenvalues;
+            return 0;
+        }
+
+        real_eigenbasis(decomposition.P,decomposition.ev_map,decomposition.complex_conjugates,decomposition.P_R);
+        decomposition.diagonalization=decomposition_case::diagonalizable;
+        return 0;
+    }
+
+
+    class bear_result;
+    bear_result bear_solve(const bear_problem& problem);
+    bear_result bear_rescale(const bear_result& result, const bear_problem& problem, double factor);
+    bear_result bear_reproject(const bear_result& result, const bear_problem& problem);
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// integration constants L (F0 - F_eq) of the initial conditions (columns of   //
+    /// F0s, dim N), with the left projection L (dim N-1) of left_projection        //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    ublas::matrix<T,ublas::column_major> project_initial_conditions(const ublas::matrix<T,ublas::column_major>& L,
+                                                                    const ublas::matrix<T,ublas::column_major>& F0s,
+                                                                    const ublas::vector<T>& F_eq)
+    {
+        const size_t red_dim=L.size1();
+        ublas::matrix<T,ublas::column_major> delta(red_dim,F0s.size2());
+        for(size_t j(0); j<F0s.size2(); j++)
+            for(size_t k(0); k<red_dim; k++)
+                delta(k,j)=F0s(k,j)-F_eq(k);
+        return ublas::prod(L,delta);
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Solution of a bear_problem, owned by the caller and independent of the      //
+    /// problem : the equilibrium fractions, the reduced system dF/dx = AF + g      //
+    /// (dim N-1) and the non-equilibrium solution F(x), given by the numeric       //
+    /// solution of the diagonalization, or by the matrix exponential propagator    //
+    /// if A is not diagonalizable (or if requested). All the accessors are const,  //
+    /// thus one result can be read by several threads at once.                     //
+    /// //////////////////////////////////////////////////////////////////////////////
+    class bear_result
+    {
+        typedef ublas::vector<double>                                        vector_d;
+        typedef ublas::matrix<double,ublas::column_major>                    matrix_d;
+
+    public:
+        bear_result() : fStatus(1),
+                        fError("not solved"),
+                        fCharge_states(),
+                        fM(), fA(), fG(),
+                        fEquilibrium(),
+                        fInitial_condition(),
+                        fMax_fraction_index(0),
+                        fSolution(),
+                        fScan_initial_conditions(),
+                        fScan_constants(),
+                        fLeft_projection(),
+                        fXmin(0.), fXmax(0.), fNpoint(0),
+                        fSampling(), fSampling_tolerance(0.)
+        {}
+        virtual ~bear_result(){}
+
+        // 0 if solved, otherwise error() tells why
+        int status() const { return fStatus; }
+        const std::string& error() const { return fError; }
+
+        std::size_t levels() const { return fCharge_states.size(); }
+        const std::vector<int>& charge_states() const { return fCharge_states; }
+
+        const matrix_d& generator_matrix() const { return fM; }    // M (dim N) of dF/dx = MF
+        const matrix_d& system_matrix() const { return fA; }       // A (dim N-1)
+        const vector_d& second_member() const { return fG; }       // g (dim N-1)
+
+        // equilibrium fractions F = -A^-1 g and F_N = 1 - sum of the others
+        const vector_d& equilibrium() const { return fEquilibrium; }
+
+        // <q> at equilibrium
+        double mean_charge() const
+        {
+            double mean_charge=0.;
+            for(std::size_t i(0); i<fEquilibrium.size(); i++)
+                mean_charge+=fCharge_states[i]*fEquilibrium(i);
+            return mean_charge;
+        }
+
+        // non-equilibrium solution available (initial conditions given)
+        bool dynamic() const { return !fInitial_condition.empty(); }
+        const vector_d& initial_condition() const { return fInitial_condition; }
+        std::size_t max_fraction_index() const { return fMax_fraction_index; }
+
+        // parameter scan : the K initial conditions of the problem (dim N x K), and their
+        // integration constants (dim N-1 x K, empty if the propagator is used)
+        std::size_t scan_size() const { return fScan_initial_conditions.size2(); }
+        const matrix_d& scan_initial_conditions() const { return fScan_initial_conditions; }
+        const matrix_d& scan_constants() const { return fScan_constants; }
+
+        // numeric solution of the diagonalization, empty if the propagator is used
+        const bear_numeric_solution<double>& solution() const { return fSolution; }
+        bool diagonalized() const { return !fSolution.empty(); }
+
+        // solved with initial conditions (or a scan) : the decomposition, if any, is done and
+        // other initial conditions can be projected on it (see bear_reproject)
+        bool projectable() const { return dynamic() || scan_size()>0; }
+
+        // F(x), dim N, at any thickness
+        int eval(double x, vector_d& F) const
+        {
+            if(!dynamic())
+                return 1;
+            if(diagonalized())
+            {
+                fSolution.eval(x,F);
+                return 0;
+            }
+
+            // F(x) = F_eq + exp(Ax) (F0 - F_eq)
+            const std::size_t dim=fA.size1();
+            matrix_d E;
+            matrix_d Ax=fA*x;
+            if(expm(Ax,E))
+                return 1;
+            vector_d delta(dim);
+            for(std::size_t i(0); i<dim; i++)
+                delta(i)=fInitial_condition(i)-fEquilibrium(i);
+            vector_d Edelta=ublas::prod(E,delta);
+            F=fEquilibrium;
+            double sum=0.;
+            for(std::size_t i(0); i<dim; i++)
+            {
+                F(i)+=Edelta(i);
+                sum+=Edelta(i);
+            }
+            F(dim)-=sum;
+            return 0;
+        }
+
+        // F on the thickness grid of the problem (empty table without initial conditions)
+        int tabulate(thickness_table<double>& table) const
+        {
+            return tabulate(fSampling,fXmin,fXmax,fNpoint,table,fSampling_tolerance);
+        }
+
+        // F on another thickness grid : the decomposition does not depend on the grid. The
+        // adaptive sampling needs the eigen decomposition, the propagator uses the log grid
+        int tabulate(const std::string& sampling, double xmin, double xmax, std::size_t npoint,
+                     thickness_table<double>& table, double sampling_tolerance=1.e-4) const
+        {
+            table.clear();
+            if(!dynamic())
+                return 0;
+
+            if(diagonalized() && sampling=="adaptive")
+            {
+                // grid refined until the linear interpolation error is below the tolerance
+                thickness_sampler<double> sampler;
+                sampler.set_tolerance(sampling_tolerance);
+                vector_d F;
+                auto evaluate=[this,&F](double x, double* Fx)
+                {
+                    fSolution.eval(x,F);
+                    std::copy(F.begin(),F.end(),Fx);
+                };
+                return sampler.sample(evaluate,xmin,xmax,levels(),table);
+            }
+
+            if(table.set_grid(sampling,xmin,xmax,npoint,levels()))
+                return 1;
+            if(diagonalized())
+                return fSolution.tabulate(table);
+
+            bear_propagator<double> propagator;
+            if(propagator.init(fA,fEquilibrium))
+                return 1;
+            return propagator.tabulate(fInitial_condition,table);
+        }
+
+        // one table per initial condition of the scan, on the thickness grid of the problem
+        int tabulate_scan(std::vector<thickness_table<double> >& tables) const
+        {
+            return tabulate_scan(fSampling,fXmin,fXmax,fNpoint,tables);
+        }
+
+        // on another thickness grid. The adaptive sampling refines the grid of one solution,
+        // thus the scan uses the log grid instead, shared by all the tables
+        int tabulate_scan(const std::string& sampling, double xmin, double xmax, std::size_t npoint,
+                          std::vector<thickness_table<double> >& tables) const
+        {
+            tables.assign(scan_size(),thickness_table<double>());
+            if(tables.empty())
+                return 0;
+            if(tables[0].set_grid(sampling,xmin,xmax,npoint,levels()))
+                return 1;
+            return tabulate_scan_on_grid(tables);
+        }
+
+        // at the thicknesses x (increasing)
+        int tabulate_scan(const std::vector<double>& x, std::vector<thickness_table<double> >& tables) const
+        {
+            tables.assign(scan_size(),thickness_table<double>());
+            if(tables.empty())
+                return 0;
+            tables[0].set_grid(x,levels());
+            return tabulate_scan_on_grid(tables);
+        }
+
+    private:
+        friend bear_result bear_solve(const bear_problem& problem);
+        friend bear_result bear_rescale(const bear_result& result, const bear_problem& problem, double factor);
+        friend bear_result bear_reproject(const bear_result& result, const bear_problem& problem);
+
+        // initial conditions (and those of the scan) and thickness grid of the problem, once
+        // their dimension and normalization are checked
+        int set_initial_conditions(const bear_problem& problem)
+        {
+            const std::size_t dim=fCharge_states.size();
+            const vector_d& F0=problem.initial_condition;
+            const matrix_d& F0s=problem.initial_conditions;
+            if(!F0.empty() && F0.size()!=dim)
+                return fail("the initial conditions do not match the number of charge states");
+            if(F0s.size2()>0 && F0s.size1()!=dim)
+                return fail("the initial conditions of the scan do not match the number of charge states");
+
+            fXmin=problem.thickness_minimum;
+            fXmax=problem.thickness_maximum;
+            fNpoint=problem.thickness_point_number;
+            fSampling=problem.sampling;
+            fSampling_tolerance=problem.sampling_tolerance;
+            fMax_fraction_index=0;
+            fInitial_condition.resize(0,false);
+            fScan_initial_conditions.resize(0,0,false);
+            if(F0.empty() && F0s.size2()==0)
+                return 0;
+
+            if(!F0.empty())
+            {
+                double sum_init_cond=0.;
+                double max_initial_cond=0.;
+                for(std::size_t i(0); i<dim; i++)
+                {
+                    sum_init_cond+=F0(i);
+                    if(F0(i)>max_initial_cond)
+                    {
+                        max_initial_cond=F0(i);
+                        fMax_fraction_index=i;
+                    }
+                }
+                if(!normalized(sum_init_cond,dim))
+                    return fail("provided initial conditions are not normalized (sum different from 1)");
+            }
+            for(std::size_t j(0); j<F0s.size2(); j++)
+            {
+                double sum_init_cond=0.;
+                for(std::size_t i(0); i<dim; i++)
+                    sum_init_cond+=F0s(i,j);
+                if(!normalized(sum_init_cond,dim))
+                    return fail("initial conditions "+std::to_string(j)+" of the scan are not normalized (sum different from 1)");
+            }
+            if(problem.sampling!="linear" && problem.sampling!="log" && problem.sampling!="adaptive")
+                return fail("unknown thickness sampling '"+problem.sampling+"' (linear, log or adaptive)");
+            fInitial_condition=F0;
+            fScan_initial_conditions=F0s;
+            return 0;
+        }
+
+        // the tables of the scan on the grid of the first one
+        int tabulate_scan_on_grid(std::vector<thickness_table<double> >& tables) const
+        {
+            if(diagonalized())
+                return fSolution.tabulate(fScan_constants,tables);
+
+            bear_propagator<double> propagator;
+            if(propagator.init(fA,fEquilibrium))
+                return 1;
+            return propagator.tabulate(fScan_initial_conditions,tables);
+        }
+
+        int fail(const std::string& error)
+        {
+            fStatus=1;
+            fError=error;
+            return 1;
+        }
+
+        int fStatus;
+        std::string fError;
+        std::vector<int> fCharge_states;
+        matrix_d fM;                        // generator matrix (dim N)
+        matrix_d fA;                        // reduced system matrix (dim N-1)
+        vector_d fG;                        // second member (dim N-1)
+        vector_d fEquilibrium;              // dim N
+        vector_d fInitial_condition;        // dim N
+        std::size_t fMax_fraction_index;    // level of the max. initial fraction
+        bear_numeric_solution<double> fSolution;
+        matrix_d fScan_initial_conditions;  // dim N x K
+        matrix_d fScan_constants;           // dim N-1 x K
+        matrix_d fLeft_projection;          // L (dim N-1), empty if the propagator is used
+
+        // thickness grid of the table
+        double fXmin;
+        double fXmax;
+        std::size_t fNpoint;
+        std::string fSampling;
+        double fSampling_tolerance;
+    };
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Reentrant solver : everything is computed from the problem into the result   //
+    /// (no global state, no logging, no shared summary). The steps are the ones of  //
+    /// bear_equations and solve_bear_equations :                                   //
+    ///   M(p,q) = Q(q,p), M(p,p) = - Sum(m != p) Q(p,m)                            //
+    ///   A(p,q) = M(p,q) - M(p,N), g(p) = M(p,N)                 (dim N-1)         //
+    ///   F_eq = -A^-1 g, then A = P D P^-1 and the integration constants of        //
+    ///   F0 - F_eq, or the propagator exp(Ax) if A is not diagonalizable.          //
+    /// The K initial conditions of a scan share the decomposition : their         //
+    /// constants are L (F0s - F_eq), L being the left projection matrix.           //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline bear_result bear_solve(const bear_problem& problem)
+    {
+        typedef ublas::vector<double>                                        vector_d;
+        typedef ublas::matrix<double,ublas::column_major>                    matrix_d;
+        typedef ublas::matrix<std::complex<double>,ublas::column_major>      matrix_c;
+
+        bear_result result;
+        const std::size_t dim=problem.charge_states.size();
+        const matrix_d& Q=problem.cross_sections;
+        if(dim<2)
+        {
+            result.fail("the system needs at least 2 charge states");
+            return result;
+        }
+        if(Q.size1()!=dim || Q.size2()!=dim)
+        {
+            result.fail("the cross-section matrix does not match the number of charge states");
+            return result;
+        }
+        result.fCharge_states=problem.charge_states;
+        if(result.set_initial_conditions(problem))
+            return result;
+        const vector_d& F0=problem.initial_condition;
+        const matrix_d& F0s=problem.initial_conditions;
+
+        try
+        {
+            /// /////////////////////////////////////////////////////
+            // generator matrix, reduced system (F_N = 1 - sum of the others) and equilibrium
+            matrix_d& M=result.fM;
+            fill_generator_matrix(Q,dim,M);
+            const std::size_t red_dim=dim-1;
+            matrix_d& A=result.fA;
+            vector_d& g=result.fG;
+            reduce_system(M,A,g);
+            lu_solver<matrix_d> A_lu;
+            if(solve_equilibrium(A,g,A_lu,result.fEquilibrium))
+            {
+                result.fail("LU factorization failed, the matrix of the system is singular");
+                return result;
+            }
+            const vector_d& F_eq=result.fEquilibrium;
+
+            // without initial conditions only the equilibrium is needed, and the propagator
+            // needs no decomposition
+            if(!result.projectable() || problem.propagator)
+            {
+                result.fStatus=0;
+                result.fError.clear();
+                return result;
+            }
+
+            /// /////////////////////////////////////////////////////
+            // diagonalization A = P D P^-1, or the propagator if there is no real eigenbasis
+            eigen_decomposition decomposition;
+            if(decompose(A,decomposition))
+            {
+                result.fail("diagonalize_gen lapack function returned an error");
+                return result;
+            }
+            if(decomposition.diagonalization==decomposition_case::null_spectrum)
+            {
+                result.fail("could not identify the matrix decomposition method to use");
+                return result;
+            }
+            if(decomposition.diagonalization!=decomposition_case::diagonalizable)
+            {
+                result.fStatus=0;
+                result.fError.clear();
+                return result;
+            }
+            const matrix_c& P=decomposition.P;
+            const matrix_c& P_inv=decomposition.P_inv;
+            const std::map<size_t, std::complex<double> >& ev_map=decomposition.ev_map;
+            const std::vector<std::tuple<size_t,size_t,std::complex<double> > >& complex_conjugates=decomposition.complex_conjugates;
+            const matrix_d& P_R=decomposition.P_R;
+
+            // integration constants of F0 - F_eq (zero without initial conditions : only the
+            // decomposition is kept for the scan)
+            vector_d coef(red_dim,0.);
+            if(!F0.empty())
+            {
+                vector_d delta(red_dim);
+                for(std::size_t k(0); k<red_dim; k++)
+                    delta(k)=F0(k)-F_eq(k);
+                if(project_on_left_eigenvectors(P,P_inv,ev_map,complex_conjugates,delta,coef))
+                {
+                    result.fail("left and right eigenvectors are orthogonal (defective eigenvalue)");
+                    return result;
+                }
+            }
+
+            // and of all the initial conditions of the scan, in one product : L is kept for the
+            // initial conditions of further problems (see bear_reproject)
+            if(left_projection(P,P_inv,ev_map,complex_conjugates,result.fLeft_projection))
+            {
+                result.fail("left and right eigenvectors are orthogonal (defective eigenvalue)");
+                return result;
+            }
+            if(F0s.size2()>0)
+                result.fScan_constants=project_initial_conditions(result.fLeft_projection,F0s,F_eq);
+
+            if(result.fSolution.init(P_R,coef,ev_map,complex_conjugates,F_eq))
+            {
+                result.fail("could not form the numeric solution (dimension mismatch)");
+                return result;
+            }
+        }
+        catch(std::exception& e)
+        {
+            result.fail(std::string("could not solve system : ")+e.what());
+            return result;
+        }
+
+        result.fStatus=0;
+        result.fError.clear();
+        return result;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Solution of a problem whose cross-sections are factor times the ones of a    //
+    /// solved result, and with the same initial conditions (e.g. another target    //
+    /// mass, density or unit : the scale factor of the cross-sections changes).    //
+    /// Then M, A and g are scaled, F_eq = -A^-1 g is unchanged, the eigenvalues    //
+    /// are scaled and the eigenvectors and integration constants unchanged :       //
+    /// F(x) -> F(factor x), without a new decomposition. The thickness grid is     //
+    /// the one of the problem.                                                     //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline bear_result bear_rescale(const bear_result& result, const bear_problem& problem, double factor)
+    {
+        bear_result rescaled(result);
+        if(result.status())
+            return rescaled;
+        if(!(factor>0.) || !std::isfinite(factor))
+        {
+            rescaled.fail("the scale factor of the cross-sections must be positive");
+            return rescaled;
+        }
+        if(problem.charge_states!=result.charge_states())
+        {
+            rescaled.fail("the rescaled problem does not have the charge states of the result");
+            return rescaled;
+        }
+        if(problem.sampling!="linear" && problem.sampling!="log" && problem.sampling!="adaptive")
+        {
+            rescaled.fail("unknown thickness sampling '"+problem.sampling+"' (linear, log or adaptive)");
+            return rescaled;
+        }
+
+        rescaled.fM*=factor;
+        rescaled.fA*=factor;
+        rescaled.fG*=factor;
+        rescaled.fSolution.scale(factor);
+
+        rescaled.fXmin=problem.thickness_minimum;
+        rescaled.fXmax=problem.thickness_maximum;
+        rescaled.fNpoint=problem.thickness_point_number;
+        rescaled.fSampling=problem.sampling;
+        rescaled.fSampling_tolerance=problem.sampling_tolerance;
+        return rescaled;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Solution of a problem with the cross-sections and method of a solved result, //
+    /// but other initial conditions (and those of the scan) : the decomposition    //
+    /// does not depend on them, thus their integration constants are L (F0 - F_eq) //
+    /// with the left projection L of the result, without a new diagonalization.   //
+    /// The result must have been solved with initial conditions (projectable).    //
+    /// The thickness grid is the one of the problem.                              //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline bear_result bear_reproject(const bear_result& result, const bear_problem& problem)
+    {
+        typedef ublas::vector<double>                                        vector_d;
+        typedef ublas::matrix<double,ublas::column_major>                    matrix_d;
+
+        bear_result reprojected(result);
+        if(result.status())
+            return reprojected;
+        if(!result.projectable())
+        {
+            reprojected.fail("the result was solved without initial conditions, there is no decomposition to project on");
+            return reprojected;
+        }
+        if(problem.charge_states!=result.charge_states())
+        {
+            reprojected.fail("the reprojected problem does not have the charge states of the result");
+            return reprojected;
+        }
+        if(reprojected.set_initial_conditions(problem))
+            return reprojected;
+
+        reprojected.fScan_constants.resize(0,0,false);
+        if(!result.diagonalized())
+            return reprojected;
+
+        try
+        {
+            const vector_d& F_eq=result.fEquilibrium;
+            const matrix_d& L=result.fLeft_projection;
+            vector_d coef(L.size1(),0.);
+            if(reprojected.dynamic())
+            {
+                matrix_d F0(problem.initial_condition.size(),1);
+                ublas::column(F0,0)=problem.initial_condition;
+                coef=ublas::column(project_initial_conditions(L,F0,F_eq),0);
+            }
+            if(reprojected.fSolution.set_constants(coef))
+            {
+                reprojected.fail("could not form the numeric solution (dimension mismatch)");
+                return reprojected;
+            }
+            if(reprojected.scan_size())
+                reprojected.fScan_constants=project_initial_conditions(L,problem.initial_conditions,F_eq);
+        }
+        catch(std::exception& e)
+        {
+            reprojected.fail(std::string("could not project the initial conditions : ")+e.what());
+        }
+        return reprojected;
+    }
+}
+
+#endif	/* BEAR_CORE_H */
@@ -22,6 +22,9 @@
 #include "generate_equations.h"
 #include "options_manager.h"
 #include "bear_user_interface.h"
+#include "cross_section_parser.h"
+#include "bear_problem.h"
+#include "bear_system.h"
 #include "def.h"
 
 namespace ublas = boost::numeric::ublas;
@@ -50,7 +53,7 @@ namespace bear
         ublas::range fCoef_range_i;
         ublas::range fCoef_range_j;
         ublas::range fSystem_range;
-        std::map<std::pair<size_t,size_t>, data_type> fCoef_list;
+        cross_section_table fCoef_table;
         matrix_d fMat;
         vector_d f2nd_member;
         vector_d fF0;
@@ -83,6 +86,10 @@ namespace bear
         int dynamic_eq_system();
         //case dF/dx = MF = 0 with dim(M) = N
         int static_eq_system();
+        // full rate matrix M (dim N) of dF/dx = MF, built from the coefficient table in O(N^2)
+        int generator_matrix(matrix_d& M) const;
+        // system read from the input file, for the reentrant core (bear_solve)
+        int get_problem(bear_problem& problem) const;
         // temp, compute a simple formula taken into account a capture and loss of a single electron (c.f. Betz)
         std::vector<double> get_1electron_approximation_solution();
         
@@ -98,63 +105,6 @@ namespace bear
             return fF0;
         }
         
-    protected:
-        /// ////////////////////////////////////////////////////////////////////////////////
-        // Function below are helper functions to compute the matrix element of the final system
-        // same as Kronecker-Delta symbol, to help finding the matrix elements of the system of equations
-        data_type Fpq(size_t k, size_t q)
-        {
-            if(k==q)
-                return data_type(1);
-            else
-                return data_type(0);
-        }
-        // provide element below diagonal of the matrix eq system
-        data_type ionization_sum(size_t i, size_t q)
-        {
-            typedef std::pair<size_t,size_t> coef;
-            data_type val=data_type();
-            LOG(MAXDEBUG)<<"fCoef_index_min="<<fCoef_index_min;
-            LOG(MAXDEBUG)<<"fEqDim="<<fEqDim;
-            for(size_t j(fCoef_index_min);j<=i-1;j++)
-            {
-                LOG(MAXDEBUG)<<"i="<<i <<" j="<<j<<"  q="<<q;
-                val+=fCoef_list.at(coef(j,i))*Fpq(j,q);
-                LOG(MAXDEBUG)<<"val="<<val;
-            }
-            return val;
-        }
-        // provide element above diagonal of the matrix eq system
-        data_type recombination_sum(size_t i, size_t q)
-        {
-            typedef std::pair<size_t,size_t> coef;
-            data_type val=data_type();
-            for(size_t s(i+1);s<=fCoef_index_min+fEqDim-1;s++)
-                val+=fCoef_list.at(coef(s,i))*Fpq(s,q);
-            return val;
-        }
-        // provide diagonal element of the matrix eq system
-        data_type diagonal_sum(size_t i, size_t q)
-        {
-            typedef std::pair<size_t,size_t> coef;
-            data_type val=data_type();
-            for(size_t m(i+1);m<=fCoef_index_min+fEqDim-1;m++)
-                val+=fCoef_list.at(coef(i,m))*Fpq(i,q);
-            for(size_t k(fCoef_index_min);k<=i-1;k++)
-                val+=fCoef_list.at(coef(i,k))*Fpq(i,q);
-            return val;
-        }
-        data_type compute_matrix_element(size_t p, size_t q)
-        {
-            data_type val=data_type();
-            LOG(MAXDEBUG)<<"ionization_sum";
-            val=ionization_sum(p,q);
-            LOG(MAXDEBUG)<<"recombination_sum";
-            val+=recombination_sum(p,q);
-            LOG(MAXDEBUG)<<"diagonal_sum";
-            val-=diagonal_sum(p,q);
-            return val;
-        }
     };
 }
 
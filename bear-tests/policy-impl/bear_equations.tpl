@@ -15,7 +15,7 @@ namespace bear
                                 fCoefDim(9),
                                 fCoef_range_i(),
                                 fCoef_range_j(),
-                                fCoef_list(),
+                                fCoef_table(),
                                 fMat(),
                                 f2nd_member(),
                                 fF0(), fCoef_index_min(0), fCoef_index_max(0),fIni_cond_map()
@@ -59,175 +59,73 @@ namespace bear
     int bear_equations<T,U>::read_impl()
     {
         LOG(DEBUG)<<"in read_impl() ...";
-        ublas::range input_coef_range_i(  fvarmap.at("coef.index.i.min").template as<size_t>() , 
-                                          fvarmap.at("coef.index.i.max").template as<size_t>()+1
-                                       );
-        ublas::range input_coef_range_j(  fvarmap.at("coef.index.j.min").template as<size_t>() , 
-                                          fvarmap.at("coef.index.j.max").template as<size_t>()+1
-                                       );
         
-        
-
-        LOG(DEBUG)<<"init coefficients description ...";
-        /// use prog options to parse input data file
-        // define options_description of the coefs
-        options_description input_file_desc("input file description");
-        options_description coef_desc("cross-sections description");
+        LOG(DEBUG)<<"init input header description ...";
+        /// use prog options to convert the header entries of the input data file
         options_description header_desc("cross-sections header description");
-        options_description ic_desc("Initial conditions");
-        
-        ui_type::init_initial_condition_descriptions(
-                                            ic_desc,
-                                            fvarmap.at("coef.index.i.min").template as<size_t>() , 
-                                            fvarmap.at("coef.index.i.max").template as<size_t>()+1
-                                       );
-        ui_type::init_coef_descriptions(coef_desc);
         ui_type::init_input_header_descriptions(header_desc);
-        input_file_desc.add(header_desc).add(coef_desc).add(ic_desc);
         
+        // read the input data file in a single pass (UTF8 BOM is handled by the parser) : 
+        // cross-sections Qij and initial conditions F0i are stored directly in a dense table,
+        // and the remaining header entries are returned as key/value pairs
+        path filename=fvarmap["input-file"].template as<path>();
+        cross_section_parser parser;
+        ui_type::init_input_parser(parser);
         
+        LOG(MAXDEBUG)<<"parse data file "<<filename.string()<<" ...";
+        
+        if(parser.parse(filename.string()))
+            return 1;
         
-        // parse and fill vm
         variables_map vm;
-
-        // But before parsing must handle UTF8 BOM case...
-        path filename=fvarmap["input-file"].template as<path>();
-        path filename_out=filename.parent_path();
-        filename_out/=filename.stem();
-        filename_out+=".bear.txt";
-
-        std::ifstream infile(filename.string());
+        if(ui_type::parse_input_header(parser.header(),header_desc,vm))
+            return 1;
         
-
-        bool UTF8=false;
-        if (infile.good())
-        {
-            std::string line;
-            getline(infile, line);
-            if (line.compare( 0, 3, "\xEF\xBB\xBF" ) == 0)
-            {
-                line.erase( 0, 3 );
-                UTF8=true;
-            }
-            
-            if(UTF8)
-            {
-                std::ofstream outfile(filename_out.string());
-                while(getline(infile, line))
-                {
-                    outfile<<line<<std::endl;
-                }        
-                outfile.close();
-            }
-        }
-
-        infile.close();
+        double scale_factor=ui_type::scale_factor(vm);
         
-        path file_to_parse;
-        if(UTF8)
-            file_to_parse=filename_out;
-        else
-            file_to_parse=filename;
-
-        LOG(MAXDEBUG)<<"parse data file "<<file_to_parse.string()<<" ...";
-
-        if(ui_type::parse_cfgFile(file_to_parse.string(),input_file_desc,vm,false))
-            return 1;
-
-         double scale_factor=ui_type::scale_factor(vm);
+        fSummary->thickness_minimum=vm.at("thickness.minimum").template as<double>();
+        fSummary->thickness_maximum=vm.at("thickness.maximum").template as<double>();
+        fSummary->thickness_point_number=vm.at("thickness.point.number").template as<std::size_t>();
         
-        // get vm data into the fCoef_list container 
-        fCoef_list.clear();
-
-        size_t index_i_min = std::numeric_limits<size_t>::max(); 
-        size_t index_i_max = std::numeric_limits<size_t>::min();
-        size_t index_j_min = std::numeric_limits<size_t>::max(); 
-        size_t index_j_max = std::numeric_limits<size_t>::min();
-
-        // go over user-provided indices and if the 
-        // matrix element Qij is found as non defaulted, 
-        // store the indices and value in fCoef_list map
         LOG(DEBUG)<<"searching for coefficients ...";
+        if(parser.coefficients().empty())
+        {
+            LOG(ERROR)<<"no cross-section coefficient found in file "<<filename.string();
+            return 1;
+        }
         
+        // get parsed data into the fCoef_table container 
+        fCoef_table=parser.coefficients();
+        for(size_t i(fCoef_table.index_min()); i<=fCoef_table.index_max(); i++)
+            for(size_t j(fCoef_table.index_min()); j<=fCoef_table.index_max(); j++)
+                if(fCoef_table.defined(i,j))
+                    LOG(DEBUG)<<"found cross-section coefficient : "<< ui_type::form_coef_key(i,j) <<" = "<< fCoef_table(i,j);
+        fCoef_table.scale(scale_factor);
         
-        
-        for(const auto& i : input_coef_range_i)
-            for(const auto& j : input_coef_range_j)
-            {
-                std::string key=ui_type::form_coef_key(i,j);
-                //LOG(DEBUG)<<"Q."<<i<<"."<<j<<" = "<<key;
-                if(vm.count(key))
-                {
-                    //LOG(DEBUG)<<"counted";
-
-                    if(!vm.at(key).defaulted())
-                    {
-                        LOG(DEBUG)<<"found cross-section coefficient : "<< key <<" = "<< vm.at(key).as<data_type>();
-
-                        std::pair<size_t,size_t> coef_key(i,j);
-                        data_type coef_val=vm.at(key).as<data_type>()*scale_factor;
-                        fCoef_list.insert( std::make_pair(coef_key, coef_val) );
-
-                        // to resize matrix properly :
-                        // get the max/min indices of the coef.
-                        // this is necessary to avoid having rows or column full of zeros
-                        if(i<index_i_min)
-                            index_i_min=i;
-
-                        if(i>index_i_max)
-                            index_i_max=i;
-
-                        if(j<index_j_min)
-                            index_j_min=j;
-
-                        if(j>index_j_max)
-                            index_j_max=j;
-
-                        LOG(MAXDEBUG)<<" i="<< i << " min="<<index_i_min <<" max="<<index_i_max;
-                        LOG(MAXDEBUG)<<" j="<< j << " min="<<index_j_min <<" max="<<index_j_max;
-                    }
-                }
-            }
-
-        fCoef_index_min=index_i_min;
-        fCoef_index_max=index_i_max;
+        fCoef_index_min=parser.index_i_min();
+        fCoef_index_max=parser.index_i_max();
         // get new range objects (index_i_max + 1 to include last index)
-        ublas::range coef_range_i(index_i_min,index_i_max+1);
-        ublas::range coef_range_j(index_j_min,index_j_max+1);
+        ublas::range coef_range_i(parser.index_i_min(),parser.index_i_max()+1);
+        ublas::range coef_range_j(parser.index_j_min(),parser.index_j_max()+1);
         // and update the corresponding private members
         fCoef_range_i=coef_range_i;
         fCoef_range_j=coef_range_j;
         
         // do the same for initial conditions
-        index_i_min = std::numeric_limits<size_t>::max(); 
-        index_i_max = std::numeric_limits<size_t>::min();
-        index_j_min = std::numeric_limits<size_t>::max(); 
-        index_j_max = std::numeric_limits<size_t>::min();
-
-        
+        fIni_cond_map.clear();
+        for(const auto& p : parser.initial_conditions())
+        {
+            LOG(DEBUG)<<"found initial conditions : "<< ui_type::form_init_cond_key(p.first) <<" == "<< p.second;
+            fIni_cond_map.insert(std::make_pair(p.first, static_cast<data_type>(p.second)) );
+        }
         
-        for(const auto& i : input_coef_range_i)
+        if(fIni_cond_map.empty())
         {
-            std::string key=ui_type::form_init_cond_key(i);
-            if(vm.count(key))
-            {
-                if(!vm.at(key).defaulted())
-                {
-                    data_type val=vm.at(key).as<data_type>();
-                    LOG(DEBUG)<<"found initial conditions : "<< key <<" == "<< val;
-                    
-                    data_type ic_val=vm.at(key).as<data_type>();
-                    fIni_cond_map.insert(std::make_pair(i, ic_val) );
-                    if(i<index_i_min)
-                            index_i_min=i;
-
-                    if(i>index_i_max)
-                        index_i_max=i;
-                }
-            }
+            LOG(ERROR)<<"no initial conditions found in file "<<filename.string();
+            return 1;
         }
         
-        ublas::range init_cond_range(index_i_min,index_i_max+1);
+        ublas::range init_cond_range(fIni_cond_map.begin()->first,fIni_cond_map.rbegin()->first+1);
         fEqDim=fvarmap["eq-dim"].template as<size_t>();
 
 
@@ -284,36 +182,11 @@ namespace bear
 
         fEqDim=fCoef_range_i.size();
 
-        // if all checks are fine, fill missing coefs in new reduced range with zeros :
-        for(const auto& i : fCoef_range_i)
-            for(const auto& j : fCoef_range_j)
-            {
-                std::pair<size_t,size_t> coef_key(i,j);
-                if(!fCoef_list.count(coef_key))
-                {
-                    fCoef_list.insert( std::make_pair(coef_key, 0) );
-                }
-            }
+        // if all checks are fine, missing coefs in the reduced range are already zeros in fCoef_table
 
         size_t dim=fCoef_range_i.size();
         size_t offset=fCoef_range_i.start();        
 
-        if (ui_type::fUse_cfgFile)
-        {
-            if (fs::exists(ui_type::fConfig_file_path))
-            {
-                if (ui_type::parse_cfgFile(ui_type::fConfig_file_path.string(), ic_desc, ui_type::fvarmap, true))
-                    return 1;
-            }
-            else
-            {
-                LOG(ERROR)<<"config file '"<< fConfig_file_path <<"' not found";
-                return 1;
-            }
-
-        }
-        
-        
         vector_d F0(dim); 
         for(const auto& p : fIni_cond_map)
         {
@@ -366,16 +239,13 @@ namespace bear
     int bear_equations<T,U>::static_eq_system()
     {
         size_t dim=fCoef_range_i.size();
-        size_t offset=fCoef_range_i.start();
-        size_t last_index=offset+dim-1;
 
-        matrix_d mat(dim,dim);
-        for(const auto& p : fCoef_range_i)
-            for(const auto& q : fCoef_range_j)
-                if(last_index != p)
-                    mat(p-offset,q-offset)=compute_matrix_element(p,q);
-                else
-                    mat(dim-1,q-offset)=1.0;
+        matrix_d mat;
+        if(generator_matrix(mat))
+            return 1;
+        // replace last equation by the normalization condition
+        for(size_t q(0);q<dim;q++)
+            mat(dim-1,q)=1.0;
 
         // clear and copy
         fMat.clear();
@@ -419,37 +289,82 @@ namespace bear
             for(const auto& p : fSummary->F_index_map)
                 LOG(DEBUG)<<" index " << p.first << " -> "<<p.second;
 
-            // system is reduced by one dimension due to condition FN=1-Sum(k=1 to N-1) Fk
-            matrix_d mat(dim-1,dim-1);
-            for(const auto& p : reduced_range)
-                for(const auto& q : reduced_range)
-                {
-                    LOG(MAXDEBUG)<<" coef("<<p<<","<<q <<")"<< " offset="<<offset;
-                    LOG(MAXDEBUG)<<" mat("<<p-offset<<","<<q-offset <<")"<< " offset="<<offset;
-                    
-                    mat(p-offset,q-offset)=compute_matrix_element(p,q)-compute_matrix_element(p,last_index);
-                    LOG(MAXDEBUG)<<"mat("<<p<<","<<q <<") = "<< mat(p-offset,q-offset);
-                }
+            // system is reduced by one dimension due to condition FN=1-Sum(k=1 to N-1) Fk :
+            // A(p,q) = M(p,q) - M(p,N) and g(p) = M(p,N)
+            matrix_d M;
+            if(generator_matrix(M))
+                return 1;
 
-            // clear and copy
             fMat.clear();
-            fMat=mat;
-            vector_d Cte(reduced_range.size());
-            for(const auto& p : reduced_range)
-            {
-                Cte(p-offset)=compute_matrix_element(p,last_index);
-                LOG(MAXDEBUG)<<"p-offset="<<p-offset << " <-> v("<< p <<")="<<compute_matrix_element(p,last_index);
-            }
-            //std::cout<<Cte<<std::endl;
-            // clear and copy
             f2nd_member.clear();
-            f2nd_member=Cte;
+            reduce_system(M,fMat,f2nd_member);
         }
 
         return 0;
     }
     
     
+    /// ////////////////////////////////////////////////////////////////////////////////
+    // rate matrix of dF/dx = MF with dim(M) = N (see fill_generator_matrix), from the 
+    // coefficient table : row q of the table is contiguous
+    template <typename T, typename U >
+    int bear_equations<T,U>::generator_matrix(matrix_d& M) const
+    {
+        size_t dim=fCoef_range_i.size();
+        size_t offset=fCoef_range_i.start();
+        
+        if(dim==0 || !fCoef_table.contains(offset,offset) || !fCoef_table.contains(offset+dim-1,offset+dim-1))
+        {
+            LOG(ERROR)<<"coefficient table does not cover the index range of the system";
+            return 1;
+        }
+        
+        const size_t stride=fCoef_table.dim();
+        const double* Q=fCoef_table.data()+(offset-fCoef_table.index_min())*(stride+1);
+        fill_generator_matrix([Q,stride](size_t q, size_t p){ return Q[q*stride+p]; },dim,M);
+        
+        return 0;
+    }
+    
+    
+    /// ////////////////////////////////////////////////////////////////////////////////
+    // charge states, scaled cross-sections and initial conditions of the system (after read()), 
+    // with the thickness grid of the input file and the solver options of the command line
+    template <typename T, typename U >
+    int bear_equations<T,U>::get_problem(bear_problem& problem) const
+    {
+        size_t dim=fCoef_range_i.size();
+        size_t offset=fCoef_range_i.start();
+        
+        if(dim==0 || fF0.size()!=dim || !fCoef_table.contains(offset,offset) || !fCoef_table.contains(offset+dim-1,offset+dim-1))
+        {
+            LOG(ERROR)<<"coefficient table does not cover the index range of the system";
+            return 1;
+        }
+        
+        problem.charge_states.resize(dim);
+        problem.cross_sections.resize(dim,dim,false);
+        for(size_t j(0);j<dim;j++)
+            for(size_t i(0);i<dim;i++)
+                problem.cross_sections(i,j)=fCoef_table(offset+i,offset+j);
+        for(size_t i(0);i<dim;i++)
+            problem.charge_states[i]=static_cast<int>(offset+i);
+        problem.initial_condition=fF0;
+        
+        problem.thickness_minimum=fSummary->thickness_minimum;
+        problem.thickness_maximum=fSummary->thickness_maximum;
+        problem.thickness_point_number=fSummary->thickness_point_number;
+        if(fvarmap.count("sampling"))
+            problem.sampling=fvarmap.at("sampling").template as<std::string>();
+        if(fvarmap.count("sampling-tolerance"))
+            problem.sampling_tolerance=fvarmap.at("sampling-tolerance").template as<double>();
+        if(fvarmap.count("propagator"))
+            problem.propagator=fvarmap.at("propagator").template as<bool>();
+        
+        return 0;
+    }
+    
+    
     /// ////////////////////////////////////////////////////////////////////////////////
     // temporary
     template <typename T, typename U >
@@ -461,18 +376,17 @@ namespace bear
         size_t coef_index_min=fCoef_index_min-1;
         
         //F1
-        typedef std::pair<size_t,size_t> coef;
         std::vector<double> ana_sol;
         //data_type coef_val=vm.at(coef(14,15)).as<data_type>();
         //*
-        double denominator=1+fCoef_list.at(coef(coef_index_min+syst_dim-1,coef_index_min+syst_dim))/fCoef_list.at(coef(coef_index_min+syst_dim,coef_index_min+syst_dim-1));
+        double denominator=1+fCoef_table.at(coef_index_min+syst_dim-1,coef_index_min+syst_dim)/fCoef_table.at(coef_index_min+syst_dim,coef_index_min+syst_dim-1);
         //double denominator=1+fQ[14][15]/fQ[15][14];
         //std::cout<<"denominator (1) = "<<denominator<<std::endl;
 
         for(int i(coef_index_min+syst_dim-2);i>coef_index_min;i--)
         {
             //denominator*=fQ[i][i+1]/fQ[i+1][i];
-            denominator*=fCoef_list.at(coef(i,i+1))/fCoef_list.at(coef(i+1,i));
+            denominator*=fCoef_table.at(i,i+1)/fCoef_table.at(i+1,i);
             denominator+=1.0;
             //std::cout<<"denominator ("<<i<<") = "<<denominator<<std::endl;
         }
@@ -490,7 +404,7 @@ namespace bear
         {
             LOG(MAXDEBUG)<<"i="<<i;
             //Fip1=Fi*(fQ[i][i+1]/fQ[i+1][i]);
-            Fip1=Fi*(fCoef_list.at(coef(i,i+1))/fCoef_list.at(coef(i+1,i)));
+            Fip1=Fi*(fCoef_table.at(i,i+1)/fCoef_table.at(i+1,i));
             LOG(MAXDEBUG)<<"F"<<i+1<<"="<<Fip1;
             ana_sol.push_back(Fip1);
             Fi=Fip1;
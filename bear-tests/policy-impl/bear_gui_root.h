@@ -26,28 +26,38 @@
 #include "logger.h"
 #include "def.h"
 #include "handle_root_signal.h"
+#include "bear_numeric_solution.h"
+#include "bear_table_output.h"
 
 namespace bear
 {
-    class bear_gui_root
+    // evaluate one level of the numeric solution for TF1 (no formula parsing)
+    struct bear_level_function
+    {
+        const bear_numeric_solution<double>* solution;
+        std::size_t row;
+        
+        double operator()(double* x, double* /*par*/)
+        {
+            return solution->eval(row,x[0]);
+        }
+    };
+    
+    class bear_gui_root : public bear_table_output
     {
         
     public:
         
-        enum method {kDiagonalization,kRungeKutta};
+        enum method {kDiagonalization,kRungeKutta,kTabulated};
         
-        bear_gui_root() :   fCanvas(nullptr), 
+        bear_gui_root() :   bear_table_output(),
+                            fCanvas(nullptr), 
                             fLegend(nullptr),   
                             fFunctions(),   
-                            fXmin(0.),  
-                            fXmax(20.),     
                             fYmin(0.),  
                             fYmax(1.1),
-                            fNpoint(1000),
-                            fMaxop(100000),
-                            fMaxpar(100000),
-                            fMaxconst(100000),
                             fFunctions_derivative(),
+                            fLevel_functions(),
                             fSingal_handler(),
                             fOut_fig_filename()
         {
@@ -60,10 +70,7 @@ namespace bear
         
         int init(const variables_map& vm,const variables_map& vm2)
         {
-            
-            fXmin=vm.at("thickness.minimum").template as<double>();
-            fXmax=vm.at("thickness.maximum").template as<double>();
-            fNpoint=vm.at("thickness.point.number").template as<std::size_t>();
+            bear_table_output::init(vm,vm2);
             
             fYmin=vm.at("fraction.minimum").template as<double>();
             fYmax=vm.at("fraction.maximum").template as<double>();
@@ -103,9 +110,6 @@ namespace bear
             fLegend->SetNColumns(4);
 
             LOG(DEBUG)<<"init(variable_map)";
-            fMaxop=vm2.at("formula-maximum-operator").template as<int>();
-            fMaxpar=vm2.at("formula-maximum-parameter").template as<int>();
-            fMaxconst=vm2.at("formula-maximum-constant").template as<int>();
             
             fs::path input=vm2["input-file"].template as<fs::path>();
             std::string filename=input.stem().string();
@@ -118,19 +122,13 @@ namespace bear
             fSave_ne=vm2["save-fig-ne"].template as<bool>();
             
             
+            
             fOut_fig_filename=output;            
             
             return 0;
         }
 
         
-        int init_summary(std::shared_ptr<bear_summary> const& summary) 
-        {
-            fSummary = summary;
-            return 0;
-        }
-        
-        
         int compute_equilibrium_distance()
         {
             double epsilon=0.0001;
@@ -143,76 +141,55 @@ namespace bear
             return 0;
         }
         
-        int print_table()
+        // init functions/histos
+        int init(const bear_numeric_solution<double>& solution)
         {
+            fMethod=kDiagonalization;
+            //fCanvas = std::make_shared<TCanvas>("c1Dia","Solutions - Diagonalization",800,600);
             
-            std::ostringstream os_title;
-            os_title<< std::setw(16)
-                    //<<std::left
-                    << bstream_centered("X") << "    ";
-            for(auto& p : fFunctions)
-            {
-                os_title<< std::setw(16)
-                        //<<std::left
-                        << bstream_centered("F"+std::to_string( p.first + 1)) << "    ";
-            }
-            os_title<<std::setw(16)
-                    //<<std::left
-                    <<bstream_centered("Sum");
-            LOG(RESULTS)<<os_title.str();
-            double N=(double)fNpoint;
-            double step =(fXmax-fXmin)/N;
-            double sum=0;
-            for(int i(0);i<fNpoint;i++)
+            // keep a copy : TF1 functors point to it
+            bear_table_output::init(solution);
+            
+            for(std::size_t row(0); row<fSolution.size(); row++)
             {
-                sum=0;
-                std::ostringstream os_eval;
-                double idoub = (double)i;
-                double x=idoub*step+fXmin;
-                os_eval<< std::setw(16)
-                        //<<std::left
-                        //<< std::setprecision(10) 
-                        << std::scientific
-                        <<bstream_centered(to_string_scientific(x))<<"    ";
-                for(auto& p : fFunctions)
-                {
-                    
-                    os_eval << std::setw(16)
-                            //<<std::left
-                            //<< std::setprecision(12) 
-                            << bstream_centered(to_string_scientific(p.second->Eval(x))) << "    ";
-                    sum+=p.second->Eval(x);
-                }
-                os_eval << std::setw(16)
-                        //<< std::left 
-                        << bstream_centered(to_string_scientific(sum));
-                LOG(RESULTS)<<os_eval.str();
+                std::string name = "F" + std::to_string(fSummary->F_index_map.at(row));
+                fLevel_functions[row].solution=&fSolution;
+                fLevel_functions[row].row=row;
+                fFunctions[row] = std::make_shared<TF1>(name.c_str(), 
+                                                        &fLevel_functions[row], 
+                                                        &bear_level_function::operator(), 
+                                                        fXmin, fXmax, 0, 
+                                                        "bear_level_function", "operator()");
+                fFunctions.at(row)->SetNpx(fNpoint);
+                fFunctions.at(row)->SetLineColor(row+1);
+                fLegend->AddEntry(fFunctions[row].get(), name.c_str());
             }
             return 0;
         }
         
-        
-        
-        // init functions/histos
-        int init(const std::map<std::size_t, std::string>& input_functions)
+        // tabulated solution (propagator, Runge-Kutta) : used for the table, and for 
+        // the plot when there is nothing else to draw (A not diagonalizable)
+        int init(const thickness_table<double>& table)
         {
-            //Int_t maxop=std::numeric_limits<Int_t>::max();
-            //Int_t maxpar=std::numeric_limits<Int_t>::max();
-            //Int_t maxconst=std::numeric_limits<Int_t>::max();
-            
+            if(table.empty())
+                return 0;
             
-            fMethod=kDiagonalization;
-            //fCanvas = std::make_shared<TCanvas>("c1Dia","Solutions - Diagonalization",800,600);
+            bear_table_output::init(table);
+            if(!fFunctions.empty() || !fHistograms.empty())
+                return 0;
             
-            
-            for(const auto& p : input_functions)
+            fMethod=kTabulated;
+            std::vector<double> edges = table.bin_edges(fXmax-fXmin);
+            for(std::size_t row(0); row<table.levels(); row++)
             {
-                std::string name = "F" + std::to_string(fSummary->F_index_map.at(p.first));
-                fFunctions[p.first] = std::make_shared<TF1>(name.c_str(), p.second.c_str(), fXmin, fXmax);
-                fFunctions.at(p.first)->SetNpx(fNpoint);
-                fFunctions.at(p.first)->SetLineColor(p.first+1);
-                fFunctions.at(p.first)->SetMaxima(fMaxop,fMaxpar,fMaxconst);
-                fLegend->AddEntry(fFunctions[p.first].get(), name.c_str());
+                std::string name = "F" + std::to_string(fSummary->F_index_map.at(row));
+                fHistograms[row] = std::make_shared<TH1D>(name.c_str(),name.c_str(),table.points(),&edges[0]);
+                for(std::size_t k(0); k<table.points(); k++)
+                    fHistograms.at(row)->SetBinContent(k+1,table(row,k));
+                fHistograms.at(row)->SetLineColor(row+1);
+                fHistograms.at(row)->SetLineWidth(2);
+                fHistograms.at(row)->SetStats(kFALSE);
+                fLegend->AddEntry(fHistograms[row].get(), name.c_str());
             }
             return 0;
         }
@@ -244,6 +221,9 @@ namespace bear
             if(fMethod==kDiagonalization)
                 return draw(fFunctions);
             
+            if(fMethod==kTabulated)
+                return draw(fHistograms);
+            
             //temporary hack
             if(fMethod==kRungeKutta)
                 return init(fHistograms,true);
@@ -268,7 +248,7 @@ namespace bear
             fCanvas = std::make_shared<TCanvas>("c1Dia","Solutions - Diagonalization",800,600);
             
             
-            if(fMethod!=kRungeKutta && fMethod!=kDiagonalization)
+            if(fMethod!=kRungeKutta && fMethod!=kDiagonalization && fMethod!=kTabulated)
                 throw std::runtime_error("Unrecognized method to solve the equations");
             
             fSingal_handler.set_canvas(fCanvas.get());
@@ -320,20 +300,14 @@ namespace bear
         //std::map<std::size_t, TF1*> fFunctions;
         std::map<std::size_t, std::shared_ptr<TF1> > fFunctions;
         std::map<std::size_t, std::shared_ptr<TF1> > fFunctions_derivative;
-        double fXmin;
-        double fXmax;
         double fYmin;
         double fYmax;
         std::string fTitle;
         std::string fXTitle;
         std::string fYTitle;
-        std::size_t fNpoint;
         enum method fMethod;
-        std::shared_ptr<bear_summary> fSummary;
         std::map<std::size_t, std::shared_ptr<TH1D> > fHistograms;
-        Int_t fMaxop;
-        Int_t fMaxpar;
-        Int_t fMaxconst;
+        std::map<std::size_t, bear_level_function> fLevel_functions;
         
         handle_root_signal fSingal_handler;
         std::string fOut_fig_filename;
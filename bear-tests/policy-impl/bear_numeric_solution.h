@@ -0,0 +1,470 @@
+/*
+ * File:   bear_numeric_solution.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BEAR_NUMERIC_SOLUTION_H
+#define	BEAR_NUMERIC_SOLUTION_H
+
+#include <map>
+#include <tuple>
+#include <vector>
+#include <cmath>
+#include <complex>
+#include <algorithm>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+// bindings
+#ifdef HAS_LAPACK_BINDINGS
+#include "boost/numeric/bindings/blas/blas3.hpp"
+#include "boost/numeric/bindings/traits/ublas_matrix.hpp"
+#endif
+
+#include "def.h"
+#include "thickness_table.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Compact numeric representation of the non-equilibrium solution.             //
+    ///                                                                             //
+    ///   F(x) = F_eq + W * E(x)                                                    //
+    ///                                                                             //
+    /// W is the real eigenbasis P_R (dim N-1) extended by one row for the last     //
+    /// level (F_N = 1 - sum of the others), and E(x) the mode amplitudes :         //
+    ///   real mode k          : E_k  = C_k exp(lambda x)                           //
+    ///   complex pair (k,k')  : E_k  = exp(lambda x) ( C_k cos(wx) + C_k' sin(wx) )//
+    ///                          E_k' = exp(lambda x) ( C_k' cos(wx) - C_k sin(wx) )//
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    class bear_numeric_solution
+    {
+        typedef T                                                              data_type;
+        typedef ublas::vector<data_type>                                        vector_d;
+        typedef ublas::matrix<data_type,ublas::column_major>                    matrix_d;
+
+        typedef std::map<size_t, std::complex<data_type> >                     eigen_value_map;
+        typedef std::vector<std::tuple<size_t, size_t, std::complex<double> > > complex_eigen_values;
+
+    public:
+
+        struct mode
+        {
+            std::size_t index;      // column of the real eigenbasis
+            std::size_t index_bar;  // column of the complex conjugate partner (complex pair only)
+            data_type lambda;       // real part of the eigenvalue
+            data_type omega;        // imaginary part of the eigenvalue (0 for real modes)
+            bool is_complex;
+        };
+
+        bear_numeric_solution() :   fModes(),
+                                    fBasis(),
+                                    fConstants(),
+                                    fEquilibrium()
+        {}
+        virtual ~bear_numeric_solution(){}
+
+
+        int init(   const matrix_d& P_R,
+                    const vector_d& unknown_coef,
+                    const eigen_value_map& eig_val_map,
+                    const complex_eigen_values& eig_val_c,
+                    const vector_d& particular_solution,
+                    double unit_convertor=1.)
+        {
+            std::size_t dim=P_R.size1();
+            if(P_R.size2()!=dim || unknown_coef.size()!=dim || particular_solution.size()!=dim+1)
+                return 1;
+
+            fModes.clear();
+            for(const auto& p : eig_val_c)
+            {
+                mode m;
+                std::complex<double> eigenvalue;
+                std::tie(m.index,m.index_bar,eigenvalue) = p;
+                m.lambda=eigenvalue.real()*unit_convertor;
+                m.omega=eigenvalue.imag()*unit_convertor;
+                m.is_complex=true;
+                fModes.push_back(m);
+            }
+
+            for(const auto& p : eig_val_map)
+            {
+                mode m;
+                m.index=p.first;
+                m.index_bar=p.first;
+                m.lambda=p.second.real()*unit_convertor;
+                m.omega=data_type();
+                m.is_complex=false;
+                fModes.push_back(m);
+            }
+
+            // extend P_R with the last level : F_N = 1 - sum_i F_i
+            fBasis.resize(dim+1,dim,false);
+            for(std::size_t k(0); k<dim; k++)
+            {
+                data_type column_sum=data_type();
+                for(std::size_t i(0); i<dim; i++)
+                {
+                    fBasis(i,k)=P_R(i,k);
+                    column_sum+=P_R(i,k);
+                }
+                fBasis(dim,k)=-column_sum;
+            }
+
+            fConstants=unknown_coef;
+            fEquilibrium=particular_solution;
+
+            return 0;
+        }
+
+        // same modes with other integration constants (dim N-1), i.e. other initial conditions
+        int set_constants(const vector_d& constants)
+        {
+            if(constants.size()!=fConstants.size())
+                return 1;
+            fConstants=constants;
+            return 0;
+        }
+
+        // solution of the system scaled by factor (A -> factor A) : its eigenvalues are scaled,
+        // its eigenvectors and the integration constants are unchanged, thus F(x) -> F(factor x)
+        void scale(data_type factor)
+        {
+            for(auto& m : fModes)
+            {
+                m.lambda*=factor;
+                m.omega*=factor;
+            }
+        }
+
+        // number of levels N
+        std::size_t size() const
+        {
+            return fEquilibrium.size();
+        }
+
+        bool empty() const
+        {
+            return fEquilibrium.empty();
+        }
+
+        // E(x), dim N-1
+        void mode_amplitudes(data_type x, vector_d& E) const
+        {
+            E.resize(fConstants.size(),false);
+            for(const auto& m : fModes)
+            {
+                data_type expLambdaX=std::exp(m.lambda*x);
+                if(m.is_complex)
+                {
+                    data_type coswx=std::cos(m.omega*x);
+                    data_type sinwx=std::sin(m.omega*x);
+                    E(m.index)     = expLambdaX*( fConstants(m.index)*coswx     + fConstants(m.index_bar)*sinwx );
+                    E(m.index_bar) = expLambdaX*( fConstants(m.index_bar)*coswx - fConstants(m.index)*sinwx );
+                }
+                else
+                    E(m.index) = expLambdaX*fConstants(m.index);
+            }
+        }
+
+        // F_row(x)
+        data_type eval(std::size_t row, data_type x) const
+        {
+            data_type val=fEquilibrium(row);
+            for(const auto& m : fModes)
+            {
+                data_type expLambdaX=std::exp(m.lambda*x);
+                if(m.is_complex)
+                {
+                    data_type coswx=std::cos(m.omega*x);
+                    data_type sinwx=std::sin(m.omega*x);
+                    val += fBasis(row,m.index)     * expLambdaX*( fConstants(m.index)*coswx     + fConstants(m.index_bar)*sinwx );
+                    val += fBasis(row,m.index_bar) * expLambdaX*( fConstants(m.index_bar)*coswx - fConstants(m.index)*sinwx );
+                }
+                else
+                    val += fBasis(row,m.index) * expLambdaX*fConstants(m.index);
+            }
+            return val;
+        }
+
+        // F(x), dim N
+        void eval(data_type x, vector_d& F) const
+        {
+            vector_d E;
+            mode_amplitudes(x,E);
+            F=fEquilibrium;
+            if(!E.empty())
+                F+=prod(fBasis,E);
+        }
+
+        // F at all the grid points of the table (dim N x M) : F(X) = F_eq + W E(X), where the
+        // columns of E(X) are the mode amplitudes at the points X. The table is filled by 
+        // blocks of points : the amplitudes of the block are computed first, then W E(X) 
+        // is a single matrix product (blas gemm when the bindings are available).
+        int tabulate(thickness_table<data_type>& table) const
+        {
+            static const std::size_t block_size=4096;
+            const std::size_t level_number=size();
+            const std::size_t mode_dim=fConstants.size();
+            if(table.levels()!=level_number)
+                return 1;
+
+            mode_rotation rotation;
+            const bool uniform = table.uniform() && table.points()>1;
+            if(uniform)
+                init_rotation(table.step(),rotation);
+
+            matrix_d E;
+            matrix_d C;
+            vector_d E_k;
+            for(std::size_t k0(0); k0<table.points(); k0+=block_size)
+            {
+                const std::size_t point_number=std::min(block_size,table.points()-k0);
+                if(E.size2()!=point_number)
+                {
+                    E.resize(mode_dim,point_number,false);
+                    C.resize(level_number,point_number,false);
+                }
+
+                for(std::size_t j(0); j<point_number; j++)
+                {
+                    const std::size_t k=k0+j;
+                    for(std::size_t i(0); i<level_number; i++)
+                        C(i,j)=fEquilibrium(i);
+                    if(mode_dim==0)
+                        continue;
+                    if(uniform)
+                        advance_amplitudes(k,table.x(k),rotation,&E.data()[0]+j*mode_dim);
+                    else
+                    {
+                        mode_amplitudes(table.x(k),E_k);
+                        for(std::size_t i(0); i<mode_dim; i++)
+                            E(i,j)=E_k(i);
+                    }
+                }
+
+                if(mode_dim>0)
+                    product(fBasis,E,data_type(1.),C);
+
+                const data_type* C_data=&C.data()[0];
+                std::copy(C_data,C_data+level_number*point_number,table.column(k0));
+            }
+            return 0;
+        }
+
+        // parameter scan : F^j(X) = F_eq + W E^j(X) for K sets of integration constants (the
+        // columns of constants, dim N-1 x K), on the grid of the first table. The amplitudes
+        // are E^j(X) = B^j U(X), where U(X) are the unit amplitudes exp((lambda - i omega) x)
+        // of the modes and B^j the block diagonal matrix of the constants of set j. Thus with
+        // the bases W^j = W B^j stacked in one (K N x N-1) matrix, U(X) is computed once for
+        // all the sets, and their tables are a single matrix product.
+        int tabulate(const matrix_d& constants, std::vector<thickness_table<data_type> >& tables) const
+        {
+            static const std::size_t block_size=4096;
+            const std::size_t level_number=size();
+            const std::size_t mode_dim=fConstants.size();
+            const std::size_t set_number=constants.size2();
+            if(constants.size1()!=mode_dim)
+                return 1;
+            tables.resize(set_number);
+            if(set_number==0)
+                return 0;
+            const thickness_table<data_type>& grid=tables[0];
+            if(grid.levels()!=level_number)
+                return 1;
+            for(std::size_t j(1); j<set_number; j++)
+                if(tables[j].levels()!=level_number || tables[j].grid()!=grid.grid())
+                    tables[j].set_grid(grid.grid(),level_number);
+
+            // W^j : column k of a complex pair (k,k') is C_k W_k + C_k' W_k', column k' is
+            // C_k W_k' - C_k' W_k, and column k of a real mode C_k W_k
+            matrix_d W(set_number*level_number,mode_dim);
+            for(std::size_t j(0); j<set_number; j++)
+                for(const auto& m : fModes)
+                {
+                    const data_type c=constants(m.index,j);
+                    const data_type c_bar= m.is_complex ? constants(m.index_bar,j) : data_type();
+                    for(std::size_t i(0); i<level_number; i++)
+                    {
+                        W(j*level_number+i,m.index)=c*fBasis(i,m.index)+c_bar*fBasis(i,m.index_bar);
+                        if(m.is_complex)
+                            W(j*level_number+i,m.index_bar)=c*fBasis(i,m.index_bar)-c_bar*fBasis(i,m.index);
+                    }
+                }
+
+            mode_rotation rotation;
+            const bool uniform = grid.uniform() && grid.points()>1;
+            if(uniform)
+                init_rotation(grid.step(),rotation,true);
+
+            const std::size_t point_block=std::max<std::size_t>(1,block_size/set_number);
+            matrix_d U;
+            matrix_d C;
+            for(std::size_t k0(0); k0<grid.points(); k0+=point_block)
+            {
+                const std::size_t point_number=std::min(point_block,grid.points()-k0);
+                if(U.size2()!=point_number)
+                {
+                    U.resize(mode_dim,point_number,false);
+                    C.resize(set_number*level_number,point_number,false);
+                }
+
+                // unit amplitudes of the block
+                for(std::size_t p(0); p<point_number; p++)
+                {
+                    const std::size_t k=k0+p;
+                    data_type* U_p=&U.data()[0]+p*mode_dim;
+                    if(uniform)
+                    {
+                        advance_rotation(k,grid.x(k),rotation);
+                        for(std::size_t m(0); m<fModes.size(); m++)
+                        {
+                            U_p[fModes[m].index]=rotation.re[m];
+                            if(fModes[m].is_complex)
+                                U_p[fModes[m].index_bar]=rotation.im[m];
+                        }
+                    }
+                    else
+                        for(const auto& m : fModes)
+                        {
+                            data_type expLambdaX=std::exp(m.lambda*grid.x(k));
+                            U_p[m.index]=expLambdaX*std::cos(m.omega*grid.x(k));
+                            if(m.is_complex)
+                                U_p[m.index_bar]=-expLambdaX*std::sin(m.omega*grid.x(k));
+                        }
+                }
+
+                // column p of C : F^1(x_k) - F_eq, ..., F^K(x_k) - F_eq
+                product(W,U,data_type(),C);
+                for(std::size_t p(0); p<point_number; p++)
+                {
+                    const data_type* C_p=&C.data()[0]+p*set_number*level_number;
+                    for(std::size_t j(0); j<set_number; j++)
+                    {
+                        data_type* F=tables[j].column(k0+p);
+                        for(std::size_t i(0); i<level_number; i++)
+                            F[i]=fEquilibrium(i)+C_p[j*level_number+i];
+                    }
+                }
+            }
+            return 0;
+        }
+
+        const std::vector<mode>& modes() const { return fModes; }
+        const matrix_d& basis() const { return fBasis; }
+        const vector_d& constants() const { return fConstants; }
+        const vector_d& equilibrium() const { return fEquilibrium; }
+
+    private:
+        // C = W E + beta C (blas gemm when the bindings are available)
+        static void product(const matrix_d& W, const matrix_d& E, data_type beta, matrix_d& C)
+        {
+#ifdef HAS_LAPACK_BINDINGS
+            boost::numeric::bindings::blas::gemm(data_type(1.),W,E,beta,C);
+#else
+            const std::size_t row_number=W.size1();
+            for(std::size_t j(0); j<E.size2(); j++)
+            {
+                data_type* C_j=&C.data()[0]+j*row_number;
+                if(beta==data_type())
+                    std::fill(C_j,C_j+row_number,data_type());
+                else if(beta!=data_type(1.))
+                    for(std::size_t l(0); l<row_number; l++)
+                        C_j[l]*=beta;
+                for(std::size_t i(0); i<E.size1(); i++)
+                {
+                    const data_type Eij=E(i,j);
+                    const data_type* W_i=&W.data()[0]+i*row_number;
+                    for(std::size_t l(0); l<row_number; l++)
+                        C_j[l]+=W_i[l]*Eij;
+                }
+            }
+#endif
+        }
+
+        // uniform grid of step h : the amplitudes of a mode are the real and imaginary parts of
+        //      w(x) = (C_k + i C_k') exp((lambda - i omega) x)     (C_k' = 0 for a real mode)
+        // so that w(x+h) = w(x) * exp((lambda - i omega) h). The state is stored by mode
+        // (structure of arrays) for the rotation loop to vectorize, and is recomputed
+        // exactly every anchor_interval points to bound the round-off drift.
+        struct mode_rotation
+        {
+            std::vector<data_type> re, im;          // w(x)
+            std::vector<data_type> rot_re, rot_im;  // exp((lambda - i omega) h)
+            std::vector<data_type> C_re, C_im;
+        };
+
+        // unit : C_k = 1, C_k' = 0, thus w(x) = exp((lambda - i omega) x)
+        void init_rotation(data_type h, mode_rotation& rotation, bool unit=false) const
+        {
+            const std::size_t mode_number=fModes.size();
+            for(std::vector<data_type>* v : {&rotation.re, &rotation.im, &rotation.rot_re, &rotation.rot_im, &rotation.C_re, &rotation.C_im})
+                v->assign(mode_number,data_type());
+            for(std::size_t m(0); m<mode_number; m++)
+            {
+                const mode& md=fModes[m];
+                rotation.C_re[m]= unit ? data_type(1.) : fConstants(md.index);
+                rotation.C_im[m]= (md.is_complex && !unit) ? fConstants(md.index_bar) : data_type();
+                data_type expLambdaH=std::exp(md.lambda*h);
+                rotation.rot_re[m]=expLambdaH*std::cos(md.omega*h);
+                rotation.rot_im[m]=-expLambdaH*std::sin(md.omega*h);
+            }
+        }
+
+        // amplitudes at point k (abscissa x) of the uniform grid, written in E (dim N-1)
+        void advance_amplitudes(std::size_t k, data_type x, mode_rotation& rotation, data_type* E) const
+        {
+            advance_rotation(k,x,rotation);
+            const std::size_t mode_number=fModes.size();
+            for(std::size_t m(0); m<mode_number; m++)
+            {
+                E[fModes[m].index]=rotation.re[m];
+                if(fModes[m].is_complex)
+                    E[fModes[m].index_bar]=rotation.im[m];
+            }
+        }
+
+        // w(x) at point k (abscissa x) of the uniform grid
+        void advance_rotation(std::size_t k, data_type x, mode_rotation& rotation) const
+        {
+            static const std::size_t anchor_interval=64;
+            const std::size_t mode_number=fModes.size();
+            data_type* re=&rotation.re[0];
+            data_type* im=&rotation.im[0];
+            if(k%anchor_interval==0)
+            {
+                for(std::size_t m(0); m<mode_number; m++)
+                {
+                    data_type expLambdaX=std::exp(fModes[m].lambda*x);
+                    data_type coswx=std::cos(fModes[m].omega*x);
+                    data_type sinwx=std::sin(fModes[m].omega*x);
+                    re[m]=expLambdaX*(rotation.C_re[m]*coswx+rotation.C_im[m]*sinwx);
+                    im[m]=expLambdaX*(rotation.C_im[m]*coswx-rotation.C_re[m]*sinwx);
+                }
+            }
+            else
+            {
+                const data_type* rot_re=&rotation.rot_re[0];
+                const data_type* rot_im=&rotation.rot_im[0];
+                for(std::size_t m(0); m<mode_number; m++)
+                {
+                    data_type r=re[m]*rot_re[m]-im[m]*rot_im[m];
+                    im[m]=re[m]*rot_im[m]+im[m]*rot_re[m];
+                    re[m]=r;
+                }
+            }
+        }
+
+        std::vector<mode> fModes;
+        matrix_d fBasis;           // P_R extended to N rows (dim N x N-1)
+        vector_d fConstants;       // integration constants (dim N-1)
+        vector_d fEquilibrium;     // particular solution (dim N)
+    };
+}
+#endif	/* BEAR_NUMERIC_SOLUTION_H */
+
@@ -0,0 +1,62 @@
+/*
+ * File:   bear_problem.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BEAR_PROBLEM_H
+#define	BEAR_PROBLEM_H
+
+#include <string>
+#include <vector>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+namespace bear
+{
+    namespace ublas = boost::numeric::ublas;
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Immutable description of one system : the N charge states, their cross-     //
+    /// sections Q(i,j) (level i -> level j, per unit thickness, i.e. already       //
+    /// scaled by the target density), the initial fractions (one vector and/or the //
+    /// K vectors of a parameter scan) and the thickness grid of the table. It is   //
+    /// only read by bear_solve, thus the same problem can be solved by several     //
+    /// threads at once.                                                            //
+    /// //////////////////////////////////////////////////////////////////////////////
+    struct bear_problem
+    {
+        typedef ublas::vector<double>                                        vector_d;
+        typedef ublas::matrix<double,ublas::column_major>                    matrix_d;
+
+        bear_problem() :    charge_states(),
+                            cross_sections(),
+                            initial_condition(),
+                            initial_conditions(),
+                            thickness_minimum(0.),
+                            thickness_maximum(20.),
+                            thickness_point_number(1000),
+                            sampling("linear"),
+                            sampling_tolerance(1.e-4),
+                            propagator(false)
+        {}
+
+        std::vector<int> charge_states;     // charge of the levels, dim N
+        matrix_d cross_sections;            // Q(i,j), N x N (diagonal ignored)
+        vector_d initial_condition;         // F(x=0), dim N, empty for the equilibrium only
+        matrix_d initial_conditions;        // parameter scan : other F(x=0), one per column (N x K),
+                                            // solved with the same decomposition
+
+        // thickness grid of the table
+        double thickness_minimum;
+        double thickness_maximum;
+        std::size_t thickness_point_number;
+        std::string sampling;               // linear, log or adaptive
+        double sampling_tolerance;          // max. interpolation error of the adaptive sampling
+
+        bool propagator;                    // matrix exponential propagator instead of the diagonalization
+    };
+}
+
+#endif	/* BEAR_PROBLEM_H */
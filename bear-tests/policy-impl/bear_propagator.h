@@ -0,0 +1,189 @@
+/*
+ * File:   bear_propagator.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BEAR_PROPAGATOR_H
+#define	BEAR_PROPAGATOR_H
+
+#include <vector>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "def.h"
+#include "matrix_exponential.h"
+#include "thickness_table.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Matrix exponential propagator of dF/dx = AF + g (dim A = N-1) :             //
+    ///                                                                             //
+    ///   F(x+dx) = F_eq + exp(A dx) ( F(x) - F_eq )                                //
+    ///                                                                             //
+    /// exp(A dx) is computed once per grid step, then each point of a uniform      //
+    /// thickness grid costs one matrix-vector product (on other grids exp(A dx)    //
+    /// is recomputed for each interval). It needs no eigen decomposition, thus it  //
+    /// also applies when A is not diagonalizable.                                  //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    class bear_propagator
+    {
+        typedef T                                                              data_type;
+        typedef ublas::vector<data_type>                                        vector_d;
+        typedef ublas::matrix<data_type,ublas::column_major>                    matrix_d;
+
+    public:
+        bear_propagator() : fA(), fEquilibrium(), fStep(0.), fPropagator() {}
+        virtual ~bear_propagator(){}
+
+        // A : system matrix (dim N-1), equilibrium : F_eq (dim N)
+        int init(const matrix_d& A, const vector_d& equilibrium)
+        {
+            if(A.size1()!=A.size2() || equilibrium.size()!=A.size1()+1)
+                return 1;
+            fA=A;
+            fEquilibrium=equilibrium;
+            fStep=0.;
+            fPropagator.resize(0,0,false);
+            return 0;
+        }
+
+        // E = exp(A dx)
+        int set_step(data_type dx)
+        {
+            fStep=dx;
+            matrix_d Adx=fA*dx;
+            return expm(Adx,fPropagator);
+        }
+
+        const matrix_d& propagator() const { return fPropagator; }
+
+        // F on the grid of the table, from the initial condition F(x=0)=F0
+        int tabulate(const vector_d& F0, thickness_table<data_type>& table)
+        {
+            std::size_t dim=fA.size1();
+            if(table.empty())
+                return 0;
+            if(table.levels()!=dim+1 || F0.size()<dim)
+                return 1;
+
+            if(table.uniform() && table.points()>1 && (fPropagator.size1()!=dim || fStep!=table.step()))
+                if(set_step(table.step()))
+                    return 1;
+
+            // deviation from equilibrium at the first grid point
+            vector_d delta(dim);
+            for(std::size_t i(0); i<dim; i++)
+                delta(i)=F0(i)-fEquilibrium(i);
+
+            if(table.x(0)!=0.)
+            {
+                matrix_d E0;
+                matrix_d Ax0=fA*table.x(0);
+                if(expm(Ax0,E0))
+                    return 1;
+                vector_d temp=ublas::prod(E0,delta);
+                delta.swap(temp);
+            }
+
+            vector_d next(dim);
+            for(std::size_t k(0); k<table.points(); k++)
+            {
+                data_type* F=table.column(k);
+                data_type sum=data_type();
+                for(std::size_t i(0); i<dim; i++)
+                {
+                    F[i]=fEquilibrium(i)+delta(i);
+                    sum+=delta(i);
+                }
+                // F_N = 1 - sum of the others
+                F[dim]=fEquilibrium(dim)-sum;
+
+                if(k+1<table.points())
+                {
+                    if(!table.uniform() && set_step(table.x(k+1)-table.x(k)))
+                        return 1;
+                    ublas::noalias(next)=ublas::prod(fPropagator,delta);
+                    delta.swap(next);
+                }
+            }
+            return 0;
+        }
+
+        // parameter scan : F for K initial conditions (the columns of F0s, dim N x K) on the grid
+        // of the first table. The deviations from equilibrium are propagated together, so that
+        // each exp(A dx) is computed once and applied to all of them in one matrix product.
+        int tabulate(const matrix_d& F0s, std::vector<thickness_table<data_type> >& tables)
+        {
+            const std::size_t dim=fA.size1();
+            const std::size_t set_number=F0s.size2();
+            tables.resize(set_number);
+            if(set_number==0 || tables[0].empty())
+                return 0;
+            const thickness_table<data_type>& grid=tables[0];
+            if(grid.levels()!=dim+1 || F0s.size1()<dim)
+                return 1;
+            for(std::size_t j(1); j<set_number; j++)
+                if(tables[j].levels()!=dim+1 || tables[j].grid()!=grid.grid())
+                    tables[j].set_grid(grid.grid(),dim+1);
+
+            if(grid.uniform() && grid.points()>1 && (fPropagator.size1()!=dim || fStep!=grid.step()))
+                if(set_step(grid.step()))
+                    return 1;
+
+            // deviations from equilibrium at the first grid point
+            matrix_d delta(dim,set_number);
+            for(std::size_t j(0); j<set_number; j++)
+                for(std::size_t i(0); i<dim; i++)
+                    delta(i,j)=F0s(i,j)-fEquilibrium(i);
+
+            if(grid.x(0)!=0.)
+            {
+                matrix_d E0;
+                matrix_d Ax0=fA*grid.x(0);
+                if(expm(Ax0,E0))
+                    return 1;
+                matrix_d temp=ublas::prod(E0,delta);
+                delta.swap(temp);
+            }
+
+            matrix_d next(dim,set_number);
+            for(std::size_t k(0); k<grid.points(); k++)
+            {
+                for(std::size_t j(0); j<set_number; j++)
+                {
+                    data_type* F=tables[j].column(k);
+                    data_type sum=data_type();
+                    for(std::size_t i(0); i<dim; i++)
+                    {
+                        F[i]=fEquilibrium(i)+delta(i,j);
+                        sum+=delta(i,j);
+                    }
+                    // F_N = 1 - sum of the others
+                    F[dim]=fEquilibrium(dim)-sum;
+                }
+
+                if(k+1<grid.points())
+                {
+                    if(!grid.uniform() && set_step(grid.x(k+1)-grid.x(k)))
+                        return 1;
+                    ublas::noalias(next)=ublas::prod(fPropagator,delta);
+                    delta.swap(next);
+                }
+            }
+            return 0;
+        }
+
+    private:
+        matrix_d fA;                // A (dim N-1)
+        vector_d fEquilibrium;      // F_eq (dim N)
+        data_type fStep;            // dx of the current propagator
+        matrix_d fPropagator;       // exp(A dx)
+    };
+}
+
+#endif	/* BEAR_PROPAGATOR_H */
@@ -0,0 +1,147 @@
+/*
+ * File:   bear_sweep.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BEAR_SWEEP_H
+#define	BEAR_SWEEP_H
+
+#include <deque>
+#include <cmath>
+#include <memory>
+#include <algorithm>
+
+#include "bear_problem.h"
+#include "bear_core.h"
+
+namespace bear
+{
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// true if the cross-sections of problem are factor times the ones of the      //
+    /// reference (up to rel_tol times the largest one), with the same charge       //
+    /// states, initial conditions and method : the cross-sections per unit         //
+    /// thickness are the ones of the input file multiplied by one scale factor     //
+    /// (units, N_A and target mass), thus a change of target or of units is a      //
+    /// rescaling of the same system.                                               //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline bool is_rescaling(const bear_problem& reference, const bear_problem& problem,
+                             double& factor, double rel_tol=1.e-12)
+    {
+        typedef bear_problem::matrix_d matrix_d;
+        const matrix_d& Q_ref=reference.cross_sections;
+        const matrix_d& Q=problem.cross_sections;
+        if(problem.propagator!=reference.propagator
+           || problem.charge_states!=reference.charge_states
+           || Q.size1()!=Q_ref.size1() || Q.size2()!=Q_ref.size2()
+           || problem.initial_condition.size()!=reference.initial_condition.size()
+           || !std::equal(problem.initial_condition.begin(),problem.initial_condition.end(),reference.initial_condition.begin())
+           || problem.initial_conditions.size1()!=reference.initial_conditions.size1()
+           || problem.initial_conditions.size2()!=reference.initial_conditions.size2()
+           || !std::equal(problem.initial_conditions.data().begin(),problem.initial_conditions.data().end(),
+                          reference.initial_conditions.data().begin()))
+            return false;
+
+        // factor of the sums (the diagonal is ignored), then checked on every cross-section
+        double sum_ref=0.;
+        double sum=0.;
+        double max_ref=0.;
+        for(std::size_t i(0); i<Q.size1(); i++)
+            for(std::size_t j(0); j<Q.size2(); j++)
+                if(i!=j)
+                {
+                    sum_ref+=std::abs(Q_ref(i,j));
+                    sum+=std::abs(Q(i,j));
+                    max_ref=std::max(max_ref,std::abs(Q_ref(i,j)));
+                }
+        if(!(sum_ref>0.) || !(sum>0.))
+            return false;
+        const double s=sum/sum_ref;
+        const double tol=rel_tol*s*max_ref;
+        for(std::size_t i(0); i<Q.size1(); i++)
+            for(std::size_t j(0); j<Q.size2(); j++)
+                if(i!=j && std::abs(Q(i,j)-s*Q_ref(i,j))>tol)
+                    return false;
+        factor=s;
+        return true;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Solver of the systems of a sweep (e.g. over the energy, the target or its    //
+    /// density) : the last solved systems are kept, and a problem that is a        //
+    /// rescaling of one of them is solved by bear_rescale, without a new           //
+    /// decomposition. The full bear_solve only runs when the cross-sections        //
+    /// themselves change. Not thread safe : one sweep per thread.                  //
+    /// //////////////////////////////////////////////////////////////////////////////
+    class bear_sweep
+    {
+        struct solved_system
+        {
+            bear_problem problem;
+            std::shared_ptr<const bear_result> result;
+        };
+
+    public:
+        bear_sweep(std::size_t capacity=16, double rel_tol=1.e-12) :
+                                fCapacity(std::max<std::size_t>(1,capacity)), fRel_tol(rel_tol), fSystems(),
+                                fFull_solves(0), fRescaled_solves(0), fLast_rescaled(false), fLast_factor(1.)
+        {}
+        virtual ~bear_sweep(){}
+
+        bear_result solve(const bear_problem& problem)
+        {
+            // most recent systems first : a sweep usually rescales the previous point
+            for(auto it=fSystems.rbegin(); it!=fSystems.rend(); ++it)
+            {
+                double factor=1.;
+                if(is_rescaling(it->problem,problem,factor,fRel_tol))
+                {
+                    bear_result result=bear_rescale(*it->result,problem,factor);
+                    if(result.status()==0)
+                    {
+                        ++fRescaled_solves;
+                        fLast_rescaled=true;
+                        fLast_factor=factor;
+                        return result;
+                    }
+                }
+            }
+
+            ++fFull_solves;
+            fLast_rescaled=false;
+            fLast_factor=1.;
+            bear_result result=bear_solve(problem);
+            if(result.status()==0)
+            {
+                fSystems.push_back(solved_system{problem,std::make_shared<const bear_result>(result)});
+                if(fSystems.size()>fCapacity)
+                    fSystems.pop_front();
+            }
+            return result;
+        }
+
+        // the last solve was a rescaling of a kept system, by factor
+        bool last_rescaled() const { return fLast_rescaled; }
+        double last_factor() const { return fLast_factor; }
+
+        std::size_t full_solves() const { return fFull_solves; }
+        std::size_t rescaled_solves() const { return fRescaled_solves; }
+
+        void clear()
+        {
+            fSystems.clear();
+        }
+
+    private:
+        std::size_t fCapacity;                  // max. number of systems kept
+        double fRel_tol;                        // tolerance of the rescaling test
+        std::deque<solved_system> fSystems;     // oldest first
+        std::size_t fFull_solves;
+        std::size_t fRescaled_solves;
+        bool fLast_rescaled;
+        double fLast_factor;
+    };
+}
+
+#endif	/* BEAR_SWEEP_H */
@@ -0,0 +1,134 @@
+/*
+ * File:   bear_system.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BEAR_SYSTEM_H
+#define	BEAR_SYSTEM_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "def.h"
+#include "matrix_lu_solver.h"
+
+// linear system of the balance equations, shared by the policies (bear_equations,
+// solve_bear_equations) and the reentrant core (bear_core.h)
+namespace bear
+{
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// rate matrix of dF/dx = MF with dim(M) = N, i.e. for each level p :           //
+    ///  M(p,q) = Q(q,p)                     gain from level q != p                  //
+    ///  M(p,p) = - Sum(m != p) Q(p,m)       loss of level p                         //
+    /// Q(q,p) is the cross-section from level q to level p (any type with this call //
+    /// operator). M is filled in its column-major storage order in O(N^2)          //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename cross_sections_type, typename matrix_type>
+    void fill_generator_matrix(const cross_sections_type& Q, std::size_t dim, matrix_type& M)
+    {
+        typedef typename matrix_type::value_type T;
+        M.resize(dim,dim,false);
+        for(std::size_t q(0); q<dim; q++)
+        {
+            for(std::size_t p(0); p<dim; p++)
+                M(p,q)=Q(q,p);
+
+            // recombination (m > q) first, then ionization (m < q)
+            T loss=T();
+            for(std::size_t m(q+1); m<dim; m++)
+                loss+=Q(q,m);
+            for(std::size_t m(0); m<q; m++)
+                loss+=Q(q,m);
+            M(q,q)=-loss;
+        }
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// system reduced by one dimension due to the condition FN=1-Sum(k<N) Fk :      //
+    /// dF/dx = AF + g with A(p,q) = M(p,q) - M(p,N) and g(p) = M(p,N)              //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename matrix_type, typename vector_type>
+    void reduce_system(const matrix_type& M, matrix_type& A, vector_type& g)
+    {
+        const std::size_t red_dim=M.size1()-1;
+        A.resize(red_dim,red_dim,false);
+        g.resize(red_dim,false);
+        for(std::size_t p(0); p<red_dim; p++)
+            g(p)=M(p,red_dim);
+        // column-major fill
+        for(std::size_t q(0); q<red_dim; q++)
+            for(std::size_t p(0); p<red_dim; p++)
+                A(p,q)=M(p,q)-g(p);
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// inverse of reduce_system : rate matrix M (dim N) from A and g, with          //
+    /// M(p,q) = A(p,q) + g(p), M(p,N) = g(p) and the last row such that each column //
+    /// of M sums to zero (conservation of the fractions). A rate of the last row    //
+    /// within the round-off of its column sum is set to zero                        //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename matrix_type, typename vector_type>
+    void expand_system(const matrix_type& A, const vector_type& g, matrix_type& M)
+    {
+        typedef typename matrix_type::value_type T;
+        const std::size_t red_dim=A.size1();
+        M.resize(red_dim+1,red_dim+1,false);
+        for(std::size_t q(0); q<=red_dim; q++)
+        {
+            T sum=T();
+            T round_off=T();
+            for(std::size_t p(0); p<red_dim; p++)
+            {
+                M(p,q)= q<red_dim ? A(p,q)+g(p) : g(p);
+                sum+=M(p,q);
+                round_off+=std::abs(M(p,q));
+            }
+            round_off*=std::numeric_limits<T>::epsilon()*(red_dim+1);
+            M(red_dim,q)= (q<red_dim && std::abs(sum)<=round_off) ? T() : -sum;
+        }
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// normalization of initial fractions (sum of dim terms) : equal to 1 up to the  //
+    /// round-off of the sum, the fractions being often computed (e.g. mixtures)     //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline bool normalized(double sum, std::size_t dim)
+    {
+        return std::abs(sum-1.)<=1.e-12*dim;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// equilibrium F = -A^-1 g of the reduced system, completed with FN = 1-Sum Fk  //
+    /// (dim N). A is factorized in A_lu, kept for further solves with other second  //
+    /// members. return 1 if A is singular                                           //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename matrix_type, typename vector_type>
+    int solve_equilibrium(const matrix_type& A, const vector_type& g, lu_solver<matrix_type>& A_lu, vector_type& F_eq)
+    {
+        vector_type neg_Fi;// dim N-1
+        if(A_lu.factorize(A) || A_lu.solve(g,neg_Fi))
+            return 1;
+
+        const std::size_t red_dim=neg_Fi.size();
+        F_eq.resize(red_dim+1,false);
+        typename vector_type::value_type FN=1.;
+        for(std::size_t i(0); i<red_dim; i++)
+        {
+            F_eq(i)=-neg_Fi(i);
+            FN+=neg_Fi(i);
+        }
+        F_eq(red_dim)=FN;
+        return 0;
+    }
+}
+
+#endif	/* BEAR_SYSTEM_H */
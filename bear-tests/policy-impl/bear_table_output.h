@@ -0,0 +1,155 @@
+/*
+ * File:   bear_table_output.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BEAR_TABLE_OUTPUT_H
+#define	BEAR_TABLE_OUTPUT_H
+
+#include <string>
+#include <memory>
+#include <algorithm>
+
+#include "logger.h"
+#include "def.h"
+#include "bear_numeric_solution.h"
+#include "thickness_table.h"
+#include "thickness_sampler.h"
+#include "results_writer.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// gui policy without graphics (no ROOT) : keeps the solution of the run and   //
+    /// writes its table on the thickness grid of the sampling option into the      //
+    /// results channel. Base of bear_gui_root, and used alone where ROOT cannot    //
+    /// be (several systems solved in parallel threads).                            //
+    /// //////////////////////////////////////////////////////////////////////////////
+    class bear_table_output
+    {
+    public:
+        bear_table_output() :   fXmin(0.),
+                                fXmax(20.),
+                                fNpoint(1000),
+                                fSummary(),
+                                fSolution(),
+                                fTable(),
+                                fSampling("linear"),
+                                fSampling_tolerance(1.e-4)
+        {}
+        virtual ~bear_table_output(){}
+
+        // thickness grid of the input file and sampling options
+        int init(const variables_map& vm, const variables_map& vm2)
+        {
+            fXmin=vm.at("thickness.minimum").template as<double>();
+            fXmax=vm.at("thickness.maximum").template as<double>();
+            fNpoint=vm.at("thickness.point.number").template as<std::size_t>();
+
+            if(vm2.count("sampling"))
+                fSampling=vm2.at("sampling").template as<std::string>();
+            if(vm2.count("sampling-tolerance"))
+                fSampling_tolerance=vm2.at("sampling-tolerance").template as<double>();
+            return 0;
+        }
+
+        int init_summary(std::shared_ptr<bear_summary> const& summary)
+        {
+            fSummary = summary;
+            return 0;
+        }
+
+        // numeric solution (diagonalization), evaluated on the grid for the table
+        int init(const bear_numeric_solution<double>& solution)
+        {
+            fSolution=solution;
+            return 0;
+        }
+
+        // tabulated solution (propagator, Runge-Kutta) : written as it is
+        int init(const thickness_table<double>& table)
+        {
+            if(!table.empty())
+                fTable=table;
+            return 0;
+        }
+
+        // no graphics
+        template <typename... Args> int plot(Args&... args){return 0;}
+        template <typename... Args> int save_fig(Args&... args){return 0;}
+
+        // table of the solution written into the results channel
+        int print_table(results_writer& writer, const results_writer::table_info& info)
+        {
+            // tabulated solution available (propagator, Runge-Kutta) : write it directly
+            if(!fTable.empty())
+                return write_table(fTable,writer,info);
+
+            // otherwise evaluate the numeric solution on the whole grid first
+            thickness_table<double> table;
+            if(tabulate(table))
+                return 1;
+            return write_table(table,writer,info);
+        }
+
+        // solution on the thickness grid of the sampling option : the tabulated solution if
+        // there is one, otherwise the numeric solution evaluated on the grid (empty if none)
+        int tabulate(thickness_table<double>& table)
+        {
+            if(!fTable.empty())
+            {
+                table=fTable;
+                return 0;
+            }
+
+            table.clear();
+            if(fSolution.empty())
+                return 0;
+            if(fSampling=="adaptive")
+            {
+                // grid refined until the linear interpolation error is below the tolerance
+                thickness_sampler<double> sampler;
+                sampler.set_tolerance(fSampling_tolerance);
+                ublas::vector<double> F;
+                auto evaluate=[this,&F](double x, double* Fx)
+                {
+                    fSolution.eval(x,F);
+                    std::copy(F.begin(),F.end(),Fx);
+                };
+                if(sampler.sample(evaluate,fXmin,fXmax,fSolution.size(),table))
+                    return 1;
+                if(sampler.truncated())
+                    LOG(WARN)<<"adaptive sampling stopped at "<<table.points()<<" points, the tolerance "<<fSampling_tolerance<<" may not be reached";
+                LOG(INFO)<<"adaptive sampling : "<<table.points()<<" points (tolerance "<<fSampling_tolerance<<")";
+                return 0;
+            }
+            if(table.set_grid(fSampling,fXmin,fXmax,fNpoint,fSolution.size()))
+            {
+                LOG(ERROR)<<"unknown thickness sampling '"<<fSampling<<"' (linear, log or adaptive)";
+                return 1;
+            }
+            return fSolution.tabulate(table);
+        }
+
+        int write_table(const thickness_table<double>& table, results_writer& writer, const results_writer::table_info& info)
+        {
+            if(table.empty())
+                return 0;
+            return writer.write_table(info,&table.grid()[0],table.column(0),table.levels(),table.points());
+        }
+
+    protected:
+        double fXmin;
+        double fXmax;
+        std::size_t fNpoint;
+        std::shared_ptr<bear_summary> fSummary;
+        bear_numeric_solution<double> fSolution;
+        thickness_table<double> fTable;
+        std::string fSampling;              // thickness sampling of the table : linear, log or adaptive
+        double fSampling_tolerance;         // max. interpolation error of the adaptive sampling
+    };
+}
+
+#endif	/* BEAR_TABLE_OUTPUT_H */
@@ -8,8 +8,14 @@
 #ifndef BEAR_USER_INTERFACE_H
 #define	BEAR_USER_INTERFACE_H
 
+// std
+#include <algorithm>
+#include <sstream>
+
 // bear 
 #include "options_manager.h"
+#include "cross_section_parser.h"
+#include "units.h"
 
 namespace bear
 {
@@ -24,12 +30,9 @@ namespace bear
         std::shared_ptr<bear_summary> fSummary;
         
     protected:
-        const double N_Avogadro = 6.022140857e+23;
+        const double N_Avogadro = avogadro_number;
         std::map<std::string, double> thickness_scale;
         std::map<std::string, double> cross_section_scale;
-        //6.022140857(74)×1023 mol−1
-        //2.73159734(12)×1026 (lb-mol)−1
-        //1.707248434(77)×1025 (oz-mol)−1
         std::map<std::string,bear::severity_level> fSeverity_map; 
         
      public:
@@ -44,40 +47,13 @@ namespace bear
                                 fInfile_cmd_desc("input file options"),
                                 fInfile_cfg_desc("input file options"),
                                 fVarmap_input_file(), 
-                                thickness_scale(), 
-                                cross_section_scale(),
-                                fSeverity_map(),fInput_dim_options("input dimensions options")
+                                thickness_scale(thickness_units()), 
+                                cross_section_scale(cross_section_units()),
+                                fSeverity_map(),fInput_dim_options("input dimensions options"),
+                                fInput_required(true),
+                                fDefault_verbosity("INFO")
         {
             
-            thickness_scale["fg/cm2"]           = 1.e-15;      // femto
-            thickness_scale["pg/cm2"]           = 1.e-12;      // pico
-            thickness_scale["ng/cm2"]           = 1.e-9;       // nano
-            thickness_scale["mug/cm2"]          = 1.e-6;       // micro
-            thickness_scale["mg/cm2"]           = 1.e-3;       // milli
-            thickness_scale["cg/cm2"]           = 1.e-2;       // centi
-            thickness_scale["10 mg/cm2"]        = 1.e-2;       // centi
-            
-            thickness_scale["g/cm2"]            = 1.;            // no prefix
-            
-            thickness_scale["kg/cm2"]           = 1.e+3;        // kilo
-            thickness_scale["Mg/cm2"]           = 1.e+6;        // Mega
-            thickness_scale["Gg/cm2"]           = 1.e+9;        // Giga
-            thickness_scale["Tg/cm2"]           = 1.e+12;       // Tera
-            thickness_scale["Pg/cm2"]           = 1.e+15;       // Peta
-            
-            
-            cross_section_scale["cm2"]          = 1.;
-            cross_section_scale["1e-16 cm2"]    = 1.e-16;
-            cross_section_scale["pb"]           = 1.e-36;
-            cross_section_scale["nb"]           = 1.e-33;
-            cross_section_scale["mub"]          = 1.e-30;
-            cross_section_scale["mb"]           = 1.e-27;
-            cross_section_scale["b"]            = 1.e-24;
-            cross_section_scale["kb"]           = 1.e-21;
-            cross_section_scale["Mb"]           = 1.e-18;
-            cross_section_scale["Gb"]           = 1.e-15;
-            cross_section_scale["Tb"]           = 1.e-12;
-            
             fSeverity_map["MAXDEBUG"]           = bear::severity_level::MAXDEBUG;
             fSeverity_map["DEBUG"]              = bear::severity_level::DEBUG;
             fSeverity_map["RESULTS"]            = bear::severity_level::RESULTS;
@@ -124,14 +100,10 @@ namespace bear
             }
             
             std::string verbose=fvarmap["verbose"].as<std::string>();
+            if(fvarmap["verbose"].defaulted())
+                verbose=fDefault_verbosity;
             
-            fs::path input=fvarmap["input-file"].template as<fs::path>();
-            std::string filename=input.stem().string();
-            std::string output=fvarmap["output-directory"].template as<fs::path>().string();
-            output+="/Bear-results-";
-            output+=filename;
-            output+=".txt";
-            
+            set_log_async(fvarmap["async-log"].template as<bool>());
             
             if(fSeverity_map.count(verbose))
             {
@@ -144,15 +116,41 @@ namespace bear
             }
             
             INIT_LOG_FILE_FILTER("bear.log",GREATER_EQ_THAN,DEBUG);
+            if(fSeverity_map.count(verbose) && fSeverity_map.at(verbose)<SEVERITY_FLOOR)
+                LOG(WARN)<<"the "<<verbose<<" messages were removed at compile time (BEAR_LOG_FLOOR)";
             
-            fSummary->filename=input.filename().string();;
-            fSummary->outfilename=output;
+            if(fvarmap.count("input-file"))
+                set_output_filename(fvarmap["input-file"].template as<fs::path>());
 
             print_options();
             
             return 0;
         }
         
+        // input file of the run, the other options being already parsed (e.g. once for 
+        // a batch of input files). Neither the log nor the options are printed
+        int set_input(const variables_map& vm, const path& input)
+        {
+            fvarmap=vm;
+            replace(fvarmap,"input-file",input);
+            set_output_filename(input);
+            return 0;
+        }
+        
+        // the input file can be left out of the command line and config file, when it is 
+        // given later by set_input
+        void set_input_required(bool required)
+        {
+            fInput_required=required;
+        }
+        
+        // console verbosity when --verbose is not given (e.g. WARN for the programs that solve
+        // many systems). The log file is not affected
+        void set_default_verbosity(const std::string& verbose)
+        {
+            fDefault_verbosity=verbose;
+        }
+        
         
     void set_format(const std::string& symbol="Q", const std::string& sep1=".", const std::string& sep2=".", const std::string& sep3=".")
     {
@@ -175,10 +173,32 @@ namespace bear
         options_description fInfile_cfg_desc;
         options_description fInput_dim_options;
         variables_map fVarmap_input_file;
+        bool fInput_required;
+        std::string fDefault_verbosity;
+        
+        // results file : output-directory/Bear-results-<input file stem>.txt
+        void set_output_filename(const path& input)
+        {
+            std::string output=fvarmap["output-directory"].template as<fs::path>().string();
+            output+="/Bear-results-";
+            output+=input.stem().string();
+            output+=".txt";
+            
+            fSummary->filename=input.filename().string();
+            fSummary->outfilename=output;
+        }
         
         void init_options_descriptions()
         {
-            if (fUse_cfgFile)
+            if (!fInput_required)
+            {
+                fInfile_cmd_desc.add_options()
+                    ("input-file",po::value<path>(), "path to the input data file (list of cross-section coefficients)");
+                if (fUse_cfgFile)
+                    fInfile_cfg_desc.add_options()
+                        ("input-file",po::value<path>(), "path to the input data file (list of cross-section coefficients)");
+            }
+            else if (fUse_cfgFile)
             {
                 fInfile_cmd_desc.add_options()
                     ("input-file",po::value<path>(), "path to the input data file (list of cross-section coefficients)");
@@ -203,6 +223,14 @@ namespace bear
                 ("save",                po::value<bool>()->zero_tokens()->default_value(false),                   "print analytic solution to file")
                 ("save-fig-e",          po::value<bool>()->zero_tokens()->default_value(false),                   "print analytic solution to file")
                 ("save-fig-ne",         po::value<bool>()->zero_tokens()->default_value(false),                   "print analytic solution to file")
+                ("propagator",          po::value<bool>()->zero_tokens()->default_value(false),                   "compute the non-equilibrium table with the matrix exponential propagator")
+                ("relative-tolerance",  po::value<double>()->default_value(1.e-8),                                "relative tolerance of the step size control (Runge-Kutta method)")
+                ("absolute-tolerance",  po::value<double>()->default_value(1.e-12),                               "absolute tolerance of the step size control (Runge-Kutta method)")
+                ("sampling",            po::value<std::string>()->default_value("linear"),                        "thickness sampling of the table : linear, log or adaptive")
+                ("sampling-tolerance",  po::value<double>()->default_value(1.e-4),                                "max. linear interpolation error of the adaptive sampling (eigen decomposition only)")
+                ("async-log",           po::value<bool>()->zero_tokens()->default_value(false),                   "write the log files from a background thread")
+                ("table-format",        po::value<std::string>()->default_value("scientific"),                    "number format of the text table : scientific (7 digits) or round-trip (up to 17 digits)")
+                ("output-format",       po::value<std::string>()->default_value("text"),                          "format of the saved results : text, csv, npy or raw (float64 arrays with a json header)")
                 //("save-fig-ne-root", po::value<bool>()->zero_tokens()->default_value(false),                   "print analytic solution to file")
             
             ;
@@ -213,14 +241,8 @@ namespace bear
                 ("coef.index.i.max", po::value<size_t>()->default_value(200),                   "maximum index i of coefficient Qij")
                 ("coef.index.j.min", po::value<size_t>()->default_value(0),                     "minimum index j of coefficient Qij")
                 ("coef.index.j.max", po::value<size_t>()->default_value(200),                   "maximum index j of coefficient Qij")
-                ("formula-maximum-operator", po::value<int>()->default_value(500000),              "maximum number of operator allowed in string formulae")
-                ("formula-maximum-parameter", po::value<int>()->default_value(100000),              "maximum number of parameter allowed in string formulae")
-                ("formula-maximum-constant", po::value<int>()->default_value(100000),              "maximum number of constant allowed in string formulae")
-                
             ;
             
-            //init_initial_condition_descriptions(fBear_eq_options);
-            
             addTo_cmdLine(fGenericDesc);
             addTo_cmdLine(fInfile_cmd_desc);
             addTo_cmdLine(fBear_eq_options);
@@ -237,32 +259,34 @@ namespace bear
             fVisible_key_map["verbose"] = false;
         }
         
-        int init_coef_descriptions(options_description& desc)
+        // header entries (i.e. non cross-section keys) collected by the input file parser
+        int parse_input_header(const std::vector<cross_section_parser::key_value>& header, 
+                               const options_description& desc, 
+                               variables_map& vm)
         {
-            size_t i_min=fvarmap["coef.index.i.min"].as<size_t>();
-            size_t i_max=fvarmap["coef.index.i.max"].as<size_t>();
-            
-            size_t j_min=fvarmap["coef.index.j.min"].as<size_t>();
-            size_t j_max=fvarmap["coef.index.j.max"].as<size_t>();
-            
-            // to do : check if 0<min<max
-            
-            /// use prog options to parse input data file
-            // define options_description of the coefs
-            for(size_t i(i_min); i<i_max; i++)
-                for(size_t j(j_min); j<j_max; j++)
-                {
-                    std::string key=form_coef_key(i,j);
-                    std::string desc_str("Cross-section ");
-                    desc_str+=key;
-                    desc.add_options()
-                        (key.c_str(), po::value<double>()->default_value(0), desc_str.c_str());
-                }
-            
+            try
+            {
+                std::stringstream ss;
+                for(const auto& p : header)
+                    ss<<p.first<<"="<<p.second<<"\n";
+                po::store(po::parse_config_file(ss, desc, false), vm);
+                po::notify(vm);
+            }
+            catch(std::exception& e)
+            {
+                LOG(ERROR) << e.what();
+                return 1;
+            }
             return 0;
         }
         
-     
+        void init_input_parser(cross_section_parser& parser)
+        {
+            parser.set_format(fSymbol,fSep1,fSep2,fSep3);
+            parser.set_index_range( std::min(fvarmap["coef.index.i.min"].as<size_t>(), fvarmap["coef.index.j.min"].as<size_t>()),
+                                    std::max(fvarmap["coef.index.i.max"].as<size_t>(), fvarmap["coef.index.j.max"].as<size_t>())
+                                  );
+        }
         
         
         int init_input_header_descriptions(options_description& desc)
@@ -287,32 +311,6 @@ namespace bear
         }
         
         
-        // note : there is no dimension consistency check (TODO)
-        int init_initial_condition_descriptions(options_description& desc, size_t i_min, size_t i_max)
-        {
-            
-            for(size_t i(i_min); i<i_max; i++)
-            {
-                //std::string key=form_coef_key(i,j);
-                std::string desc_str("Initial conditions ");
-                desc_str+=std::to_string(i);
-                
-                std::string key("cross.section.F0");
-                key+=fSep1;
-                key+=std::to_string(i);
-                key+=fSep3;
-                
-                if(i==i_min)
-                    desc.add_options()
-                        (key.c_str(), po::value<double>()->default_value(1.), desc_str.c_str());
-                else
-                    desc.add_options()
-                        (key.c_str(), po::value<double>()->default_value(0.), desc_str.c_str());
-            }
-            
-            return 0;
-        }
-    
         inline std::string form_coef_key(size_t i, size_t j)
         {
             std::string key("cross.section.");
@@ -0,0 +1,255 @@
+/*
+ * File:   dormand_prince.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef DORMAND_PRINCE_H
+#define	DORMAND_PRINCE_H
+
+#include <cmath>
+#include <algorithm>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "def.h"
+#include "thickness_table.h"
+#include "logger.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Embedded Runge-Kutta 5(4) of Dormand & Prince for dF/dx = AF + g            //
+    /// (dim A = N-1), with step size control on the embedded error estimate and    //
+    /// the continuous extension of Hairer (dopri5) to get the solution at the      //
+    /// grid points of a thickness table, independently of the step sizes.         //
+    /// If the table has N rows, the last one is F_N = 1 - sum of the others.       //
+    /// All work vectors are allocated once in init().                              //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    class dormand_prince
+    {
+        typedef T                                                              data_type;
+        typedef ublas::vector<data_type>                                        vector_d;
+        typedef ublas::matrix<data_type,ublas::column_major>                    matrix_d;
+
+    public:
+        dormand_prince() :  fA(), fG(),
+                            fRtol(1.e-8), fAtol(1.e-12),
+                            fAccepted(0), fRejected(0),
+                            fY(), fY1(), fYtmp(), fErr(),
+                            fK1(), fK2(), fK3(), fK4(), fK5(), fK6(), fK7(),
+                            fR1(), fR2(), fR3(), fR4(), fR5()
+        {}
+        virtual ~dormand_prince(){}
+
+        int init(const matrix_d& A, const vector_d& g)
+        {
+            if(A.size1()!=A.size2() || g.size()!=A.size1())
+                return 1;
+            fA=A;
+            fG=g;
+            std::size_t dim=A.size1();
+            for(vector_d* v : {&fY, &fY1, &fYtmp, &fErr, &fK1, &fK2, &fK3, &fK4, &fK5, &fK6, &fK7, &fR1, &fR2, &fR3, &fR4, &fR5})
+                v->resize(dim,false);
+            return 0;
+        }
+
+        void set_tolerances(data_type rtol, data_type atol)
+        {
+            fRtol=rtol;
+            fAtol=atol;
+        }
+
+        std::size_t accepted_steps() const { return fAccepted; }
+        std::size_t rejected_steps() const { return fRejected; }
+
+        // integrate from F(x=0)=F0 up to the last grid point, and fill the table
+        int integrate(const vector_d& F0, thickness_table<data_type>& table)
+        {
+            const std::size_t dim=fA.size1();
+            fAccepted=0;
+            fRejected=0;
+            if(table.empty())
+                return 0;
+            if(F0.size()<dim || (table.levels()!=dim && table.levels()!=dim+1) || table.x(0)<0.)
+                return 1;
+
+            for(std::size_t i(0); i<dim; i++)
+                fY(i)=F0(i);
+
+            data_type x=0.;
+            const data_type xend=table.x(table.points()-1);
+            std::size_t k=0;
+
+            // grid points at x=0
+            while(k<table.points() && table.x(k)<=x)
+                store(fY,table,k++);
+
+            derivative(fY,fK1);
+            data_type h=initial_step(xend-x);
+
+            while(k<table.points())
+            {
+                if(h<=std::abs(x)*1.e-14 || !std::isfinite(h))
+                {
+                    LOG(ERROR)<<"Dormand-Prince : step size too small at x = "<<x;
+                    return 1;
+                }
+                if(x+h>xend)
+                    h=xend-x;
+
+                data_type err=step(h);
+
+                if(err<=1.)
+                {
+                    ++fAccepted;
+                    // continuous extension on [x,x+h]
+                    dense_output(h);
+                    data_type xnew = (x+h>=xend) ? xend : x+h;
+                    while(k<table.points() && table.x(k)<=xnew)
+                    {
+                        data_type theta=(table.x(k)-x)/h;
+                        interpolate(theta,fYtmp);
+                        store(fYtmp,table,k++);
+                    }
+                    x=xnew;
+                    fY.swap(fY1);
+                    fK1.swap(fK7);// FSAL : f(x+h,y1) is the first stage of the next step
+                    h*=std::min(data_type(5.),std::max(data_type(0.2),data_type(0.9)*std::pow(std::max(err,data_type(1.e-10)),data_type(-0.2))));
+                }
+                else
+                {
+                    ++fRejected;
+                    h*=std::max(data_type(0.2),data_type(0.9)*std::pow(err,data_type(-0.2)));
+                }
+            }
+            return 0;
+        }
+
+    private:
+        // k = A y + g
+        void derivative(const vector_d& y, vector_d& k) const
+        {
+            ublas::noalias(k)=ublas::prod(fA,y);
+            k+=fG;
+        }
+
+        void store(const vector_d& y, thickness_table<data_type>& table, std::size_t k) const
+        {
+            data_type* F=table.column(k);
+            data_type sum=data_type();
+            for(std::size_t i(0); i<y.size(); i++)
+            {
+                F[i]=y(i);
+                sum+=y(i);
+            }
+            if(table.levels()==y.size()+1)
+                F[y.size()]=1.-sum;
+        }
+
+        // RMS norm of v weighted by the tolerances
+        data_type norm(const vector_d& v, const vector_d& y, const vector_d& y1) const
+        {
+            if(v.size()==0)
+                return data_type();
+            data_type sum=data_type();
+            for(std::size_t i(0); i<v.size(); i++)
+            {
+                data_type sk=fAtol+fRtol*std::max(std::abs(y(i)),std::abs(y1(i)));
+                data_type r=v(i)/sk;
+                sum+=r*r;
+            }
+            return std::sqrt(sum/data_type(v.size()));
+        }
+
+        // Hairer, Norsett & Wanner, "Solving ODE I", II.4
+        data_type initial_step(data_type range) const
+        {
+            data_type d0=norm(fY,fY,fY);
+            data_type d1=norm(fK1,fY,fY);
+            data_type h = (d0<1.e-5 || d1<1.e-5) ? data_type(1.e-6) : data_type(0.01)*d0/d1;
+            return std::min(h,range);
+        }
+
+        // one step of size h from fY (fK1 = f(fY)), y1 in fY1, return the scaled error
+        data_type step(data_type h)
+        {
+            static const data_type a21=1./5.;
+            static const data_type a31=3./40.,          a32=9./40.;
+            static const data_type a41=44./45.,         a42=-56./15.,           a43=32./9.;
+            static const data_type a51=19372./6561.,    a52=-25360./2187.,      a53=64448./6561.,   a54=-212./729.;
+            static const data_type a61=9017./3168.,     a62=-355./33.,          a63=46732./5247.,   a64=49./176.,       a65=-5103./18656.;
+            static const data_type a71=35./384.,        a73=500./1113.,         a74=125./192.,      a75=-2187./6784.,   a76=11./84.;
+            static const data_type e1=71./57600.,       e3=-71./16695.,         e4=71./1920.,       e5=-17253./339200., e6=22./525.,    e7=-1./40.;
+
+            ublas::noalias(fYtmp)=fY+h*a21*fK1;
+            derivative(fYtmp,fK2);
+            ublas::noalias(fYtmp)=fY+h*(a31*fK1+a32*fK2);
+            derivative(fYtmp,fK3);
+            ublas::noalias(fYtmp)=fY+h*(a41*fK1+a42*fK2+a43*fK3);
+            derivative(fYtmp,fK4);
+            ublas::noalias(fYtmp)=fY+h*(a51*fK1+a52*fK2+a53*fK3+a54*fK4);
+            derivative(fYtmp,fK5);
+            ublas::noalias(fYtmp)=fY+h*(a61*fK1+a62*fK2+a63*fK3+a64*fK4+a65*fK5);
+            derivative(fYtmp,fK6);
+            ublas::noalias(fY1)=fY+h*(a71*fK1+a73*fK3+a74*fK4+a75*fK5+a76*fK6);
+            derivative(fY1,fK7);
+
+            ublas::noalias(fErr)=h*(e1*fK1+e3*fK3+e4*fK4+e5*fK5+e6*fK6+e7*fK7);
+            return norm(fErr,fY,fY1);
+        }
+
+        // coefficients of the continuous extension of the accepted step
+        void dense_output(data_type h)
+        {
+            static const data_type d1=-12715105075./11282082432.;
+            static const data_type d3=87487479700./32700410799.;
+            static const data_type d4=-10690763975./1880347072.;
+            static const data_type d5=701980252875./199316789632.;
+            static const data_type d6=-1453857185./822651844.;
+            static const data_type d7=69997945./29380423.;
+
+            ublas::noalias(fR1)=fY;
+            ublas::noalias(fR2)=fY1-fY;
+            ublas::noalias(fR3)=h*fK1-fR2;
+            ublas::noalias(fR4)=fR2-h*fK7-fR3;
+            ublas::noalias(fR5)=h*(d1*fK1+d3*fK3+d4*fK4+d5*fK5+d6*fK6+d7*fK7);
+        }
+
+        void interpolate(data_type theta, vector_d& y) const
+        {
+            data_type theta1=1.-theta;
+            ublas::noalias(y)=fR1+theta*(fR2+theta1*(fR3+theta*(fR4+theta1*fR5)));
+        }
+
+        matrix_d fA;
+        vector_d fG;
+        data_type fRtol;
+        data_type fAtol;
+        std::size_t fAccepted;
+        std::size_t fRejected;
+
+        // work vectors
+        vector_d fY;
+        vector_d fY1;
+        vector_d fYtmp;
+        vector_d fErr;
+        vector_d fK1;
+        vector_d fK2;
+        vector_d fK3;
+        vector_d fK4;
+        vector_d fK5;
+        vector_d fK6;
+        vector_d fK7;
+        vector_d fR1;
+        vector_d fR2;
+        vector_d fR3;
+        vector_d fR4;
+        vector_d fR5;
+    };
+}
+
+#endif	/* DORMAND_PRINCE_H */
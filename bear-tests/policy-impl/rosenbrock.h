@@ -0,0 +1,271 @@
+/*
+ * File:   rosenbrock.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef ROSENBROCK_H
+#define	ROSENBROCK_H
+
+#include <cmath>
+#include <algorithm>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "def.h"
+#include "matrix_lu_solver.h"
+#include "thickness_table.h"
+#include "logger.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// L-stable, stiffly accurate Rosenbrock method RODAS3 (Sandu et al. 1997),     //
+    /// order 3(2), for dF/dx = AF + g (dim A = N-1), suited to stiff systems       //
+    /// (rates spread over many decades). With M = I/(gamma h) - A, gamma = 1/2 :   //
+    ///                                                                             //
+    ///   M u1 = f(y)                                                               //
+    ///   M u2 = f(y) + 4/h u1                                                      //
+    ///   M u3 = f(y + 2 u1) + (u1 - u2)/h                                          //
+    ///   M u4 = f(y + 2 u1 + u3) + (u1 - u2 - 8/3 u3)/h                            //
+    ///   y_n+1 = y_n + 2 u1 + u3 + u4,     error estimate = u4                     //
+    ///                                                                             //
+    /// Since A is constant, the LU factorization of M only depends on h : it is    //
+    /// kept as long as the step size is, and the step size is only changed when    //
+    /// the controller asks to decrease it, or to increase it by more than a factor //
+    /// 1.5. The solution at the grid points of the thickness table is obtained by  //
+    /// cubic Hermite interpolation within the accepted steps.                      //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    class rosenbrock
+    {
+        typedef T                                                              data_type;
+        typedef ublas::vector<data_type>                                        vector_d;
+        typedef ublas::matrix<data_type,ublas::column_major>                    matrix_d;
+
+    public:
+        rosenbrock() :  fA(), fG(), fLU(), fLU_step(0.),
+                        fRtol(1.e-8), fAtol(1.e-12),
+                        fAccepted(0), fRejected(0), fFactorizations(0),
+                        fY(), fY1(), fF(), fF1(), fYtmp(), fRhs(), fU1(), fU2(), fU3(), fU4()
+        {}
+        virtual ~rosenbrock(){}
+
+        int init(const matrix_d& A, const vector_d& g)
+        {
+            if(A.size1()!=A.size2() || g.size()!=A.size1())
+                return 1;
+            fA=A;
+            fG=g;
+            fLU.clear();
+            fLU_step=0.;
+            std::size_t dim=A.size1();
+            for(vector_d* v : {&fY, &fY1, &fF, &fF1, &fYtmp, &fRhs, &fU1, &fU2, &fU3, &fU4})
+                v->resize(dim,false);
+            return 0;
+        }
+
+        void set_tolerances(data_type rtol, data_type atol)
+        {
+            fRtol=rtol;
+            fAtol=atol;
+        }
+
+        std::size_t accepted_steps() const { return fAccepted; }
+        std::size_t rejected_steps() const { return fRejected; }
+        std::size_t factorizations() const { return fFactorizations; }
+
+        // integrate from F(x=0)=F0 up to the last grid point, and fill the table
+        int integrate(const vector_d& F0, thickness_table<data_type>& table)
+        {
+            const std::size_t dim=fA.size1();
+            fAccepted=0;
+            fRejected=0;
+            fFactorizations=0;
+            if(table.empty())
+                return 0;
+            if(F0.size()<dim || (table.levels()!=dim && table.levels()!=dim+1) || table.x(0)<0.)
+                return 1;
+
+            for(std::size_t i(0); i<dim; i++)
+                fY(i)=F0(i);
+
+            data_type x=0.;
+            const data_type xend=table.x(table.points()-1);
+            std::size_t k=0;
+
+            // grid points at x=0
+            while(k<table.points() && table.x(k)<=x)
+                store(fY,table,k++);
+
+            derivative(fY,fF);
+            data_type h=initial_step(xend-x);
+
+            while(k<table.points())
+            {
+                if(h<=std::abs(x)*1.e-14 || !std::isfinite(h))
+                {
+                    LOG(ERROR)<<"Rosenbrock : step size too small at x = "<<x;
+                    return 1;
+                }
+
+                // the last step is shortened to end on the last grid point
+                data_type h_step = (x+h>xend) ? xend-x : h;
+
+                if(h_step!=fLU_step)
+                    if(factorize(h_step))
+                        return 1;
+
+                data_type err=step(h_step);
+
+                if(err<=1.)
+                {
+                    ++fAccepted;
+                    derivative(fY1,fF1);
+                    data_type xnew = (x+h_step>=xend) ? xend : x+h_step;
+                    while(k<table.points() && table.x(k)<=xnew)
+                    {
+                        interpolate((table.x(k)-x)/h_step,h_step,fYtmp);
+                        store(fYtmp,table,k++);
+                    }
+                    x=xnew;
+                    fY.swap(fY1);
+                    fF.swap(fF1);
+
+                    // keep h (and the factorization) unless the step can grow significantly
+                    data_type fac=data_type(0.9)*std::pow(std::max(err,data_type(1.e-10)),data_type(-1./3.));
+                    fac=std::min(data_type(5.),fac);
+                    if(fac<1. || fac>1.5)
+                        h=h_step*fac;
+                }
+                else
+                {
+                    ++fRejected;
+                    h=h_step*std::max(data_type(0.2),data_type(0.9)*std::pow(err,data_type(-1./3.)));
+                }
+            }
+            return 0;
+        }
+
+    private:
+        // k = A y + g
+        void derivative(const vector_d& y, vector_d& k) const
+        {
+            ublas::noalias(k)=ublas::prod(fA,y);
+            k+=fG;
+        }
+
+        // LU of (I/(gamma h) - A)
+        int factorize(data_type h)
+        {
+            static const data_type gamma=0.5;
+            matrix_d M=-fA;
+            for(std::size_t i(0); i<M.size1(); i++)
+                M(i,i)+=1./(gamma*h);
+            ++fFactorizations;
+            fLU_step=h;
+            if(fLU.factorize(M))
+            {
+                LOG(ERROR)<<"Rosenbrock : singular iteration matrix for h = "<<h;
+                return 1;
+            }
+            return 0;
+        }
+
+        // one step of size h from fY (fF = f(fY)), y1 in fY1, return the scaled error
+        data_type step(data_type h)
+        {
+            fLU.solve(fF,fU1);
+
+            ublas::noalias(fRhs)=fF+(4./h)*fU1;
+            fLU.solve(fRhs,fU2);
+
+            ublas::noalias(fYtmp)=fY+2.*fU1;
+            derivative(fYtmp,fRhs);
+            fRhs+=(1./h)*(fU1-fU2);
+            fLU.solve(fRhs,fU3);
+
+            fYtmp+=fU3;
+            derivative(fYtmp,fRhs);
+            fRhs+=(1./h)*(fU1-fU2-(8./3.)*fU3);
+            fLU.solve(fRhs,fU4);
+
+            ublas::noalias(fY1)=fYtmp+fU4;
+            return norm(fU4,fY,fY1);
+        }
+
+        void store(const vector_d& y, thickness_table<data_type>& table, std::size_t k) const
+        {
+            data_type* F=table.column(k);
+            data_type sum=data_type();
+            for(std::size_t i(0); i<y.size(); i++)
+            {
+                F[i]=y(i);
+                sum+=y(i);
+            }
+            if(table.levels()==y.size()+1)
+                F[y.size()]=1.-sum;
+        }
+
+        // cubic Hermite interpolation on [x, x+h] from y, f(y), y1, f(y1)
+        void interpolate(data_type theta, data_type h, vector_d& y) const
+        {
+            data_type theta2=theta*theta;
+            data_type theta3=theta2*theta;
+            data_type h00=2.*theta3-3.*theta2+1.;
+            data_type h10=theta3-2.*theta2+theta;
+            data_type h01=-2.*theta3+3.*theta2;
+            data_type h11=theta3-theta2;
+            ublas::noalias(y)=h00*fY+(h10*h)*fF+h01*fY1+(h11*h)*fF1;
+        }
+
+        // RMS norm of v weighted by the tolerances
+        data_type norm(const vector_d& v, const vector_d& y, const vector_d& y1) const
+        {
+            if(v.size()==0)
+                return data_type();
+            data_type sum=data_type();
+            for(std::size_t i(0); i<v.size(); i++)
+            {
+                data_type sk=fAtol+fRtol*std::max(std::abs(y(i)),std::abs(y1(i)));
+                data_type r=v(i)/sk;
+                sum+=r*r;
+            }
+            return std::sqrt(sum/data_type(v.size()));
+        }
+
+        data_type initial_step(data_type range) const
+        {
+            data_type d0=norm(fY,fY,fY);
+            data_type d1=norm(fF,fY,fY);
+            data_type h = (d0<1.e-5 || d1<1.e-5) ? data_type(1.e-6) : data_type(0.01)*d0/d1;
+            return std::min(h,range);
+        }
+
+        matrix_d fA;
+        vector_d fG;
+        lu_solver<matrix_d> fLU;        // LU of (I/(gamma h) - A)
+        data_type fLU_step;             // h of the current factorization
+        data_type fRtol;
+        data_type fAtol;
+        std::size_t fAccepted;
+        std::size_t fRejected;
+        std::size_t fFactorizations;
+
+        // work vectors
+        vector_d fY;
+        vector_d fY1;
+        vector_d fF;
+        vector_d fF1;
+        vector_d fYtmp;
+        vector_d fRhs;
+        vector_d fU1;
+        vector_d fU2;
+        vector_d fU3;
+        vector_d fU4;
+    };
+}
+
+#endif	/* ROSENBROCK_H */
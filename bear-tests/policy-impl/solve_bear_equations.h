@@ -22,60 +22,23 @@
 
 #include "def.h"
 #include "options_manager.h"
-#include "matrix_inverse.hpp"
+#include "matrix_lu_solver.h"
 #include "storage_adaptors.hpp"
 #include "matrix_diagonalization.h"
 #include "bear_analytic_solution.h"
+#include "bear_propagator.h"
+#include "bear_core.h"
+#include "bear_system.h"
+#include "thickness_table.h"
+#include "solve_bear_equations_base.h"
 
 
 
 namespace bear
 {
-    void remove_conjugates_from_map(std::map<size_t, std::complex<double> >& map, 
-                                    std::vector<std::tuple<size_t,size_t,std::complex<double> > >& comp_ev_container)
-    {
-        if(map.size()>0)
-        {
-            auto first=map.begin();
-            auto last=map.end();
-            while (first!=last)
-            {
-                auto first_bar=std::find_if(first,last,
-                        [&first](const std::pair<size_t,std::complex<double> >& p)
-                        {
-                            return p.second == std::conj(first->second) && p.second.imag()!=0;
-                        });
-                if(first_bar!=std::end(map))
-                {
-                    comp_ev_container.push_back(std::make_tuple(first->first,first_bar->first,first->second));
-                    map.erase(first);
-                    map.erase(first_bar);
-                    remove_conjugates_from_map(map,comp_ev_container);
-                    break;
-                }
-                else
-                {
-                    ++first;
-                }
-            }
-        }
-    }
-    
-    
-    
     template<typename T=double, typename U=bear_analytic_solution<T> >
     class solve_bear_equations : protected U
     {
-        public:
-        
-        enum class diagonalizable
-        {
-            unknown,
-            in_R,
-            in_C,
-            no
-        };
-        
         private:
           typedef T                                                              data_type;
           typedef U                                                          solution_type;
@@ -86,23 +49,18 @@ namespace bear
 
           //  equation to solve : dF/dx = AF + g <=> dF/dx = P D P^1 F + g
           matrix_d fA;                       // A
-          matrix_d fA_inv;                   // A^-1
+          lu_solver<matrix_d> fA_lu;         // LU factorization of A
           vector_d f2nd_member;              // g
-          vector_d fF0;                      // Fi(x=0)
-          vector_c fD;                       // D (stored in a vector, store only eigenvalues)
-          matrix_c fEigen_mat;               // P
-          matrix_c fEigen_mat_inv;           // P^-1
-         
-          vector_c fConstant_set;            // unknown coefficient from integration, to be determined with initial conditions
-         
+          eigen_decomposition fDecomposition; // P D P^-1, with the paired eigenvalues and real eigenbasis
           vector_d fEquilibrium_solution;    // Fi at equilibrium, should be eq to part. sol.
           //vector_d fGeneral_solution;    // homogeneous solution
           //vector_d fGeneral_solution;        // general solution = homogeneous + particular solution
-          enum diagonalizable diagonalisation_case;
           variables_map fvarmap;
           std::vector<double> fApproximated_solution;
           std::shared_ptr<bear_summary> fSummary;
+          bear_propagator<data_type> fPropagator;
         protected:
+          thickness_table<data_type> fTable;  // tabulated solution (propagator mode only)
           using solution_type::fGeneral_solution;
           using solution_type::fUnit_convertor;
           
@@ -110,16 +68,15 @@ namespace bear
         
         solve_bear_equations() : solution_type(),
                                  fA(), 
-                                 fA_inv(), 
+                                 fA_lu(), 
                                  f2nd_member(),
-                                 fF0(),
-                                 fD(), 
-                                 fEigen_mat(), 
-                                 fEigen_mat_inv(),
+                                 fDecomposition(),
                                  fEquilibrium_solution(),
                                  //fGeneral_solution(),
-                                 diagonalisation_case(diagonalizable::unknown),
-                                 fvarmap(), fApproximated_solution()
+                                 fvarmap(), fApproximated_solution(),
+                                 fSummary(),
+                                 fPropagator(),
+                                 fTable()
         {}
         virtual ~solve_bear_equations()
         {
@@ -149,11 +106,13 @@ namespace bear
                 bool staticeq=false;
                 if(staticeq)
                 {
-                    solve_staeq_at_equilibrium(mat);
+                    if(solve_staeq_at_equilibrium(mat))
+                        return 1;
                 }
                 else
                 {
-                    solve_dyneq_at_equilibrium(mat,vec);
+                    if(solve_dyneq_at_equilibrium(mat,vec))
+                        return 1;
                 }
                 
                 
@@ -163,6 +122,10 @@ namespace bear
                     return 1;
                 }
                 
+                if(use_propagator() || fDecomposition.diagonalization!=decomposition_case::diagonalizable)
+                    if(tabulate_with_propagator(mat,initial_condition))
+                        return 1;
+                
             }
             catch(std::exception& e)
             {
@@ -172,6 +135,30 @@ namespace bear
             return 0;
         }
         
+        // equilibrium solution F = -A^-1 g (dim N-1) for another second member g, 
+        // reusing the LU factorization of A computed by solve() (O(N^2))
+        int solve_at_equilibrium(const vector_d& vec, vector_d& F) const
+        {
+            if(fA_lu.solve(vec,F))
+                return 1;
+            F*=-1.;
+            return 0;
+        }
+        
+        bool save_analytic() const
+        {
+            if(fvarmap.count("save-analytic"))
+                return fvarmap.at("save-analytic").template as<bool>();
+            return false;
+        }
+        
+        bool use_propagator() const
+        {
+            if(fvarmap.count("propagator"))
+                return fvarmap.at("propagator").template as<bool>();
+            return false;
+        }
+        
         int set_approximated_solution(const std::vector<double>& vec)
         {
             fApproximated_solution=vec;
@@ -219,154 +206,52 @@ namespace bear
             fA=mat;
             f2nd_member=vec;
             
-            int diag_gen_err=diagonalize_gen(fA,fD,&fEigen_mat_inv,&fEigen_mat);
+            // ////////////////////////////////////////////////////////////////////
+            // decomposition of the core (see decompose) : without a real eigenbasis, 
+            // the solution is tabulated with the matrix exponential propagator
+            int diag_gen_err=decompose(fA,fDecomposition);
             if(diag_gen_err)
             {
                 LOG(ERROR)<<"diagonalize_gen lapack function returned error value "<<diag_gen_err;
                 return diag_gen_err;
             }
             
-            // ////////////////////////////////////////////////////////////////////
-            // if A is not diagonalizable, the lapack routine return identity matrix 
-            // for the eigenvectors and the diagonal element of A for the eigen values
-            // thus we first check the eigenvector matrices, i.e., if P==Id
-            
-            ublas::identity_matrix<double,ublas::column_major> Id(fEigen_mat.size1());
-            for(size_t i(0); i<fEigen_mat.size1();i++)
-                for(size_t j(0); j<fEigen_mat.size1();j++)
-                {
-                    if( fEigen_mat(i,j).real()==Id(i,j) )
-                    {
-                        if(fEigen_mat(i,j).imag()==0.0)
-                        {
-                            diagonalisation_case=diagonalizable::no;
-                        }
-                        else
-                        {
-                            diagonalisation_case=diagonalizable::unknown;
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        diagonalisation_case=diagonalizable::unknown;
-                        break;
-                    }
-                }
-            
-            // ////////////////////////////////////////////////////////////////////
-            // if A is diagonalizable check on which space, R or C
-            if(diagonalisation_case!=diagonalizable::no)
-            {
-                for (const auto& eigen_value : fD)
-                {
-                    if(eigen_value.imag()!=0)
-                    {
-                        diagonalisation_case=diagonalizable::in_C;
-                        break;
-                    }
-
-                    if(eigen_value.imag()==0 && eigen_value.real()!=0 )
-                    {
-                        diagonalisation_case=diagonalizable::in_R;
-                    }
-                }
-            }
-            
-            // ////////////////////////////////////////////////////////////////////
-            // 3 possibles solutions according the the property of the matrix A 
-            
-            switch (diagonalisation_case)
+            switch (fDecomposition.diagonalization)
             {
-                
-                case diagonalizable::in_R : 
-                    return solve_A_diagonalizable_in_R(initial_condition);
-                    break;
-                    
-                    //
-                case diagonalizable::in_C : 
+                case decomposition_case::diagonalizable : 
                     return solve_A_diagonalizable_in_C(initial_condition);
-                    //break;
                     
-                    //not yet implemented
-                case diagonalizable::no : 
-                    solve_A_triangularizable_in_C(initial_condition);
-                    break;
+                case decomposition_case::not_diagonalizable : 
+                    return solve_A_triangularizable_in_C(initial_condition);
+                    
+                case decomposition_case::unpaired_eigenvalues :
+                    for(const auto& p : fDecomposition.unmatched)
+                        LOG(WARN)<<"no complex conjugate found for lambda_"<<p.first+1<<" = "
+                                    <<p.second.real()<<" + "<<p.second.imag()<<" i";
+                    LOG(WARN)<<"The real eigenbasis can not be formed.";
+                    return solve_A_triangularizable_in_C(initial_condition);
                     
-                case diagonalizable::unknown :
-                    LOG(ERROR)<<"Could not identify the matrix decomposition method to use.";
-                    return 1;
-                            
                 default:
                     LOG(ERROR)<<"Could not identify the matrix decomposition method to use.";
                     return 1;
             }
-            
-            return 0;
         }
         
         
-        
-        
-        ////////////////////////////////////////////////////////////////////////////////////
-        // solve equation - case : A diagonalizable in R
-        int solve_A_diagonalizable_in_R(const vector_d& initial_condition)
-        {
-            /*LOG(DEBUG)<<"Matrix can be diagonalized in R";
-            vector_c F0(fEigen_mat_inv.size1());// dim = N-1
-            // fF0 -> dim = N
-            for(size_t i(0) ; i<fF0.size()-1 ; i++)
-            {
-                std::complex<double> complex_number(fF0(i),0.0);
-                F0(i)=complex_number;
-            }
-            fConstant_set = prod(fEigen_mat_inv,F0);
-            */
-            if(solve_A_diagonalizable_in_C(initial_condition))
-                return 1;//temp
-            return 0;
-        }
-        
         ////////////////////////////////////////////////////////////////////////////////////
         // solve equation - case : A diagonalizable in C
         int solve_A_diagonalizable_in_C(const vector_d& initial_condition)
         {
-            //////////////////////////////////////////
-            // some declarations
             LOG(DEBUG)<<"Matrix can be diagonalized in C";
-            typedef std::map<size_t, std::complex<data_type> >                           eigen_value_map;
-            typedef std::vector<std::tuple<size_t, size_t, std::complex<double> > > complex_eigen_values;
-            // create and fill map
-            eigen_value_map ev_map;
-            complex_eigen_values complex_conjugates;
-            
-            //////////////////////////////////////////
-            // store eigen_values and index in map
-            for(size_t i(0); i<fD.size(); i++)
-            {
-                ev_map.insert(std::make_pair(i,fD(i)));
-                LOG(DEBUG)<<"lambda_"<<i+1<<"="<<fD(i).real()<<" + "<<fD(i).imag()<<" i";
-            }
-            
-            // Print 
+            const matrix_c& P=fDecomposition.P;
+            const auto& ev_map=fDecomposition.ev_map;
+            const auto& complex_conjugates=fDecomposition.complex_conjugates;
+            for(size_t i(0); i<fDecomposition.D.size(); i++)
+                LOG(DEBUG)<<"lambda_"<<i+1<<"="<<fDecomposition.D(i).real()<<" + "<<fDecomposition.D(i).imag()<<" i";
             LOG(DEBUG)<<"Print complex eigen vector matrix";
-            LOG(DEBUG)<<fEigen_mat;
+            LOG(DEBUG)<<P;
             LOG(DEBUG)<<"Print complex eigen vector invert matrix";
-            LOG(DEBUG)<<fEigen_mat_inv;
-            for(const auto& p : ev_map)
-                LOG(MAXDEBUG)<<"Map("<<p.first<<")="<<p.second.real()<<" + "<<p.second.imag()<<" i";
-            
-            
-            /// //////////////////////////////////////////////////////////////////////////////
-            /// in the following we are sorting the pair of complex conjugate eigenvectors  //
-            /// and transform them so that we get a new eigenvector basis                   //
-            /// Once achieved, we search for unknown coefficients from initial conditions.  //
-            /// //////////////////////////////////////////////////////////////////////////////
-            
-            // remove complex conjugates pair from map and store them 
-            // in a vector of tuple containing index pairs + complex value
-            remove_conjugates_from_map(ev_map,complex_conjugates);
-            
+            LOG(DEBUG)<<fDecomposition.P_inv;
             
             // print in debug mode for some checks
             for(const auto& p : complex_conjugates)
@@ -379,39 +264,14 @@ namespace bear
             for(const auto& p : ev_map)
                 LOG(MAXDEBUG)<<"Map("<<p.first<<")="<<p.second.real()<<" + "<<p.second.imag()<<" i";
             
-            
-            //////////////////////////////////////////
-            // handle initial conditions x=0
             size_t dim = 2*complex_conjugates.size() + ev_map.size();
-            matrix_d P_R(dim,dim);
-            matrix_d P_R_inv(dim,dim);
-            // fill complex eigenvectors part (complex eigenvectors pairs)
+            const matrix_d& P_R=fDecomposition.P_R;
             LOG(DEBUG)<<"COMPLEX CONJUGATES = "<<complex_conjugates.size();
-            for(const auto& p : complex_conjugates)
-            {
-                size_t index=0;
-                size_t index_bar=0;
-                std::tie(index,index_bar,std::ignore) = p;
-                for(size_t i(0); i<fEigen_mat.size1(); i++)
-                {
-                    P_R(i,index)     = fEigen_mat(i,index).real();
-                    P_R(i,index_bar) = fEigen_mat(i,index).imag();
-                }
-            }
-            // fill real eigenvectors part (real eigenvalues)
             LOG(DEBUG)<<"ev_map = "<<ev_map.size();
-            for(const auto& p : ev_map)
-            {
-                for(size_t i(0); i<fEigen_mat.size1(); i++)
-                {
-                    P_R(i,p.first) = fEigen_mat(i,p.first).real();
-                }
-            }
             
             
             // /////////////////////////////////////////////////////
             // HANDLE UNKNOWN COEF
-            InvertMatrix<matrix_d>(P_R,P_R_inv);
             vector_d unknown_coef(dim);
             vector_d F0(dim);
             LOG(DEBUG)<<"dim="<<dim;
@@ -419,34 +279,9 @@ namespace bear
             for(size_t i(0); i<F0.size(); i++)
                 F0(i)=initial_condition(i);
             
-            LOG(INFO)<<" ";
-            LOG(INFO)<<"Initial conditions :";
-            double max_initial_cond=0.;
-            size_t index_max=0;
-            
-            double sum_init_cond=0.;
-            for(size_t i(0); i<initial_condition.size(); i++)
-            {
-                LOG(INFO)   <<"F"
-                            << fSummary->F_index_map.at(i)
-                            <<" (x=0) = "
-                            <<initial_condition(i);
-                sum_init_cond+=initial_condition(i);
-                if(initial_condition(i)>max_initial_cond)
-                {
-                    max_initial_cond=initial_condition(i);
-                    index_max=i;
-                }
-                
-            }
-            if(sum_init_cond!=1.)
-            {
-                LOG(ERROR)<<"Provided initial conditions is not normalized : sum = "<< sum_init_cond << " different from 1.";
-                LOG(ERROR)<<"Correct initial conditions are required to compute the non-equilibrium chage state distributions.";
+            if(check_initial_conditions(initial_condition,*fSummary))
                 return 1;
-            }
             
-            fSummary->max_fraction_index=index_max;
             vector_d vec_temp(F0.size());
             
             for(size_t k(0);k<F0.size();k++)
@@ -454,7 +289,12 @@ namespace bear
                 vec_temp(k)=F0(k)-fEquilibrium_solution(k);
             }
             
-            unknown_coef=prod(P_R_inv,vec_temp);
+            // F0-Feq = Sum_j c_j v_j, projected onto the left eigenvectors
+            if(project_on_left_eigenvectors(P,fDecomposition.P_inv,ev_map,complex_conjugates,vec_temp,unknown_coef))
+            {
+                LOG(ERROR)<<"left and right eigenvectors are orthogonal (defective eigenvalue)";
+                return 1;
+            }
             for(size_t i(0); i<unknown_coef.size(); i++)
             {
                 LOG(DEBUG)<<"C"<<i+1<<" = "<<unknown_coef(i);
@@ -463,20 +303,28 @@ namespace bear
             LOG(DEBUG)<<"PRINT P_R";
             LOG(DEBUG)<<P_R;
             
-            LOG(DEBUG)<<"PRINT P_R invert";
-            LOG(DEBUG)<<P_R_inv;
-            
             //////////////////////////////////////////////////////////////////////////////////////
-            // FORM SOLUTIONS INTO STRING, AND STORE the STRING formulae
-            // into fGeneral_solution map container
-            LOG(DEBUG)<<"FORM SOLUTIONS INTO STRING, AND STORE the STRING formulae";
-            LOG(DEBUG)<<"solution_type::init";
-            solution_type::init(fEigen_mat);
-            LOG(DEBUG)<<"solution_type::form_homogeneous_solution";
-            solution_type::form_homogeneous_solution(fEigen_mat,unknown_coef,ev_map,complex_conjugates);
-            LOG(DEBUG)<<"solution_type::form_general_solution";
-            solution_type::form_general_solution(fEquilibrium_solution);
+            // STORE the numeric solution (eigenvalues, real eigenbasis, constants, 
+            // equilibrium) into fGeneral_solution, evaluated directly by the consumers
+            LOG(DEBUG)<<"solution_type::form_numeric_solution";
+            if(solution_type::form_numeric_solution(P_R,unknown_coef,ev_map,complex_conjugates,fEquilibrium_solution))
+            {
+                LOG(ERROR)<<"Could not form the numeric solution (dimension mismatch).";
+                return 1;
+            }
             
+            //////////////////////////////////////////////////////////////////////////////////////
+            // FORM SOLUTIONS INTO STRING, only if the analytic formulae are requested
+            if(save_analytic())
+            {
+                LOG(DEBUG)<<"FORM SOLUTIONS INTO STRING, AND STORE the STRING formulae";
+                LOG(DEBUG)<<"solution_type::init";
+                solution_type::init(P);
+                LOG(DEBUG)<<"solution_type::form_homogeneous_solution";
+                solution_type::form_homogeneous_solution(P,unknown_coef,ev_map,complex_conjugates);
+                LOG(DEBUG)<<"solution_type::form_general_solution";
+                solution_type::form_general_solution(fEquilibrium_solution);
+            }
             
             
             //TODO : handle numerical errors : http://www.netlib.org/lapack/lug/node75.html
@@ -486,12 +334,33 @@ namespace bear
         
         ////////////////////////////////////////////////////////////////////////////////////
         // solve equation - case : A non-diagonalizable -> triangularizable in C for sure
+        // the triangularization is not implemented, the solution is instead tabulated 
+        // with the matrix exponential propagator (no eigen decomposition needed)
         int solve_A_triangularizable_in_C(const vector_d& initial_condition)
         {
             LOG(INFO)<<"Matrix cannot be diagonalized neither in R nor C.";
-            LOG(INFO)<<"A triangularization in C will be performed.";
-            LOG(INFO)<<"Triangularization method not implemented yet.";
-            return 1;
+            LOG(INFO)<<"The non-equilibrium solution will be computed with the matrix exponential propagator.";
+            if(check_initial_conditions(initial_condition,*fSummary))
+                return 1;
+            return 0;
+        }
+        
+        
+        ////////////////////////////////////////////////////////////////////////////////////
+        // tabulate the non-equilibrium solution with the matrix exponential propagator
+        // on the thickness grid of the input file
+        int tabulate_with_propagator(const matrix_d& mat, const vector_d& initial_condition)
+        {
+            LOG(DEBUG)<<"tabulate the non-equilibrium solution with the matrix exponential propagator";
+            if(init_table_grid(fTable,table_sampling(fvarmap),*fSummary,fEquilibrium_solution.size()))
+                return 1;
+            
+            if(fPropagator.init(mat,fEquilibrium_solution) || fPropagator.tabulate(initial_condition,fTable))
+            {
+                LOG(ERROR)<<"Could not tabulate the solution with the matrix exponential propagator.";
+                return 1;
+            }
+            return 0;
         }
         
         
@@ -503,17 +372,26 @@ namespace bear
         {
             LOG(MAXDEBUG)<<"running solve static eq";
             fA=mat;
-            InvertMatrix<matrix_d>(fA,fA_inv);
+            // last row of the system is the normalization condition : F = A^-1 e_N
+            vector_d e_N(fA.size1(),0.);
+            vector_d F;
+            if(e_N.size()>0)
+                e_N(e_N.size()-1)=1.;
+            if(fA_lu.factorize(fA) || fA_lu.solve(e_N,F))
+            {
+                LOG(ERROR)<<"LU factorization failed, the matrix of the system is singular";
+                return 1;
+            }
             LOG(DEBUG)<<" ";
             LOG(DEBUG)<<"##########################################################################";
             LOG(DEBUG)<<"#                EQUILIBRIUM CHARGE STATE DISTRIBUTION                   #";
             LOG(DEBUG)<<"##########################################################################";
             LOG(DEBUG)<<" ";
             double sum=0.0;
-            for(size_t i(0);i<fA_inv.size1();i++)
+            for(size_t i(0);i<F.size();i++)
             {
-                LOG(DEBUG)<<"F"<<i+1<<"="<<fA_inv(i,fA_inv.size1()-1);// << std::endl;
-                sum+=fA_inv(i,fA_inv.size1()-1);
+                LOG(DEBUG)<<"F"<<i+1<<"="<<F(i);// << std::endl;
+                sum+=F(i);
             }
             
             LOG(DEBUG)<<"sum = "<< sum;// << std::endl;
@@ -528,47 +406,10 @@ namespace bear
         int solve_dyneq_at_equilibrium(const matrix_d& mat, const vector_d& vec)
         {
             LOG(MAXDEBUG)<<"calling solve_dyneq_at_equilibrium function";
-            
-            
-            LOG(INFO)<<" ";
-            LOG(INFO)<<"EQUILIBRIUM CHARGE STATE DISTRIBUTION :";
             fA=mat;
             f2nd_member=vec;
-            InvertMatrix<matrix_d>(fA,fA_inv);
-
-            //std::cout << fA_inv << std::endl;
-            // todo : need to get 
-            // -index range
-            double sum=0.0;
-            double FN=1.0;
-            vector_d neg_Fi = prod(fA_inv, f2nd_member);// dim N-1
-            double mean_charge(0);
-            for(size_t i(0); i< neg_Fi.size(); i++)
-            {
-                
-                int temp = fSummary->F_index_map.at(i);
-                double charge(temp);
-                
-                fEquilibrium_solution(i)=-neg_Fi(i);
-                
-                FN+=neg_Fi(i);
-                sum+=fEquilibrium_solution(i);
-                
-                mean_charge+=charge*fEquilibrium_solution(i);
-                LOG(INFO)<<"F"<<fSummary->F_index_map.at(i)<<" = "<<fEquilibrium_solution(i);
-                fSummary->equilibrium_solutions[i] = fEquilibrium_solution(i);
-            }
-            // add the last one (1-sum)
-            fEquilibrium_solution(neg_Fi.size())=FN;
-            sum+=FN;
-            
-            fSummary->equilibrium_solutions[neg_Fi.size()]=FN;
-            size_t  last_index = neg_Fi.size()+1;
-            
-            LOG(INFO)<<"F"<< fSummary->F_index_map.at(neg_Fi.size())<<" = "<<fEquilibrium_solution(neg_Fi.size());
-            LOG(INFO)<<"sum = "<< sum;
-            
-            LOG(INFO)<<"<q> = "<< mean_charge;
+            if(solve_and_store_equilibrium(fA,f2nd_member,fA_lu,fEquilibrium_solution,*fSummary))
+                return 1;
             print_approximated_solution();
             
             
@@ -592,24 +433,13 @@ namespace bear
             /// input to copy
             fA.clear();
             f2nd_member.clear();
-            fF0.clear();
             
             fA.resize(mat.size1(),mat.size2());
             f2nd_member.resize(mat.size1());
-            fF0.resize(mat.size1()+1);// to check
             
             /// intermediate matrix and vectors
-            fA_inv.clear();
-            fD.clear();
-            fEigen_mat.clear();
-            fEigen_mat_inv.clear();
-            fConstant_set.clear();
-            
-            fA_inv.resize(mat.size1(),mat.size2());
-            fD.resize(mat.size1());
-            fEigen_mat.resize(mat.size1(),mat.size2());
-            fEigen_mat_inv.resize(mat.size1(),mat.size2());
-            fConstant_set.resize(mat.size1());
+            fA_lu.clear();
+            fDecomposition=eigen_decomposition();
             
             /// vector solutions 
             // case we use the "dynamic equations" the dimensions of the vector solution are mat.size+1
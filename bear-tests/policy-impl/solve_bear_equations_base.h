@@ -0,0 +1,271 @@
+/*
+ * File:   solve_bear_equations_base.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef SOLVE_BEAR_EQUATIONS_BASE_H
+#define	SOLVE_BEAR_EQUATIONS_BASE_H
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "def.h"
+#include "options_manager.h"
+#include "matrix_lu_solver.h"
+#include "bear_numeric_solution.h"
+#include "thickness_table.h"
+#include "bear_system.h"
+#include "logger.h"
+
+
+namespace bear
+{
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// print the initial conditions, check their normalization and store the index  //
+    /// of the max. fraction in the summary                                          //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename V>
+    int check_initial_conditions(const V& initial_condition, bear_summary& summary)
+    {
+        LOG(INFO)<<" ";
+        LOG(INFO)<<"Initial conditions :";
+        double max_initial_cond=0.;
+        size_t index_max=0;
+        double sum_init_cond=0.;
+        for(size_t i(0); i<initial_condition.size(); i++)
+        {
+            LOG(INFO)   <<"F"
+                        << summary.F_index_map.at(i)
+                        <<" (x=0) = "
+                        <<initial_condition(i);
+            sum_init_cond+=initial_condition(i);
+            if(initial_condition(i)>max_initial_cond)
+            {
+                max_initial_cond=initial_condition(i);
+                index_max=i;
+            }
+        }
+        if(!normalized(sum_init_cond,initial_condition.size()))
+        {
+            LOG(ERROR)<<"Provided initial conditions is not normalized : sum = "<< sum_init_cond << " different from 1.";
+            LOG(ERROR)<<"Correct initial conditions are required to compute the non-equilibrium chage state distributions.";
+            return 1;
+        }
+        summary.max_fraction_index=index_max;
+        return 0;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// equilibrium F = -A^-1 g of the reduced system (see solve_equilibrium),      //
+    /// printed with its mean charge and stored in the summary                       //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename M, typename V>
+    int solve_and_store_equilibrium(const M& A, const V& g, lu_solver<M>& A_lu, V& F_eq, bear_summary& summary)
+    {
+        LOG(INFO)<<" ";
+        LOG(INFO)<<"EQUILIBRIUM CHARGE STATE DISTRIBUTION :";
+        // factorize A once and solve A(-F)=g, the factorization is kept 
+        // for further solves with other second members
+        if(solve_equilibrium(A,g,A_lu,F_eq))
+        {
+            LOG(ERROR)<<"LU factorization failed, the matrix of the system is singular";
+            return 1;
+        }
+
+        double sum=0.0;
+        double mean_charge(0);
+        for(size_t i(0); i<F_eq.size(); i++)
+        {
+            sum+=F_eq(i);
+            mean_charge+=summary.F_index_map.at(i)*F_eq(i);
+            LOG(INFO)<<"F"<<summary.F_index_map.at(i)<<" = "<<F_eq(i);
+            summary.equilibrium_solutions[i] = F_eq(i);
+        }
+        LOG(INFO)<<"sum = "<< sum;
+        LOG(INFO)<<"<q> = "<< mean_charge;
+        return 0;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// options of the solve policies, with their default if absent from the map    //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline double numeric_option(const po::variables_map& vm, const std::string& key, double default_value)
+    {
+        if(vm.count(key))
+            return vm.at(key).as<double>();
+        return default_value;
+    }
+
+    // thickness sampling of the table : linear, log or adaptive
+    inline std::string table_sampling(const po::variables_map& vm)
+    {
+        if(vm.count("sampling"))
+            return vm.at("sampling").as<std::string>();
+        return "linear";
+    }
+
+    // thickness grid of the input file (see the summary), with level_number rows. The
+    // policies step through a given grid : the adaptive sampling falls back to the log grid
+    template<typename T>
+    int init_table_grid(thickness_table<T>& table, const std::string& sampling, const bear_summary& summary, std::size_t level_number)
+    {
+        if(sampling=="adaptive")
+            LOG(WARN)<<"adaptive sampling is only available for the eigen decomposition : the table uses the log grid ("
+                     <<summary.thickness_point_number<<" points), the sampling tolerance is ignored";
+        if(table.set_grid(sampling,
+                          summary.thickness_minimum,
+                          summary.thickness_maximum,
+                          summary.thickness_point_number,
+                          level_number))
+        {
+            LOG(ERROR)<<"unknown thickness sampling '"<<sampling<<"' (linear, log or adaptive)";
+            return 1;
+        }
+        return 0;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// base of the solve policies that integrate the non-equilibrium solution on    //
+    /// the thickness grid of the input file, without eigen decomposition : the      //
+    /// equilibrium is obtained by LU solve, and the derived policy only implements  //
+    /// solve_dynamic_system with its integrator. solution_type is the general       //
+    /// solution passed to the gui policy (left empty by default)                    //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T, typename solution_type=bear_numeric_solution<T> >
+    class solve_bear_equations_base
+    {
+        protected:
+          typedef T                                                              data_type;
+          typedef ublas::vector<data_type>                                        vector_d;
+          typedef ublas::matrix<data_type,ublas::column_major>                    matrix_d;
+          typedef po::variables_map                                          variables_map;
+        private:
+          //  equation to solve : dF/dx = AF + g
+          matrix_d fA;                       // A
+          lu_solver<matrix_d> fA_lu;         // LU factorization of A
+          vector_d f2nd_member;              // g
+          vector_d fEquilibrium_solution;    // Fi at equilibrium
+          variables_map fvarmap;
+          std::vector<double> fApproximated_solution;
+        protected:
+          std::shared_ptr<bear_summary> fSummary;
+          solution_type fGeneral_solution;                      // no closed form
+          thickness_table<data_type> fTable;                    // tabulated solution
+        public:
+
+        solve_bear_equations_base() :
+                                 fA(),
+                                 fA_lu(),
+                                 f2nd_member(),
+                                 fEquilibrium_solution(),
+                                 fvarmap(),
+                                 fApproximated_solution(),
+                                 fSummary(),
+                                 fGeneral_solution(),
+                                 fTable()
+        {}
+        virtual ~solve_bear_equations_base(){}
+
+        int init(const variables_map& vm)
+        {
+            fvarmap=vm;
+            return 0;
+        }
+
+        int init_summary(std::shared_ptr<bear_summary> const& summary)
+        {
+            fSummary = summary;
+            return 0;
+        }
+
+        // main function
+        int solve(const matrix_d& mat, const vector_d& vec, const vector_d& initial_condition)
+        {
+            try
+            {
+                if(mat.size1()!=mat.size2() || vec.size()!=mat.size1())
+                {
+                    LOG(ERROR) << "input matrix is not a square matrix (dim1 = "
+                               << mat.size1()
+                               << ", dim2 = "
+                               << mat.size2()
+                               << ").";
+                    return 1;
+                }
+
+                if(solve_dyneq_at_equilibrium(mat,vec))
+                    return 1;
+
+                if(check_initial_conditions(initial_condition,*fSummary))
+                    return 1;
+
+                if(solve_dynamic_system(mat,vec,initial_condition))
+                    return 1;
+            }
+            catch(std::exception& e)
+            {
+                LOG(ERROR)<< "could not solve system. Reason : " << e.what();
+                return 1;
+            }
+            return 0;
+        }
+
+        int set_approximated_solution(const std::vector<double>& vec)
+        {
+            fApproximated_solution=vec;
+            if(fApproximated_solution.size()<1)
+                return 1;
+
+            return 0;
+        }
+
+        int print_approximated_solution()
+        {
+            if(fApproximated_solution.size()<1)
+                return 1;
+
+            for(size_t i(0);i+1<fApproximated_solution.size();i++)
+                fSummary->approximated_solutions[i] = fApproximated_solution.at(i);
+            return 0;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////
+        // dynamic equations at equilibrium : F = -A^1 g
+        int solve_dyneq_at_equilibrium(const matrix_d& mat, const vector_d& vec)
+        {
+            LOG(MAXDEBUG)<<"calling solve_dyneq_at_equilibrium function";
+            fA=mat;
+            f2nd_member=vec;
+            if(solve_and_store_equilibrium(fA,f2nd_member,fA_lu,fEquilibrium_solution,*fSummary))
+                return 1;
+            print_approximated_solution();
+            return 0;
+        }
+
+        protected:
+        ////////////////////////////////////////////////////////////////////////////////////
+        // non-equilibrium solution from F(x=0) on the thickness grid of the input file
+        virtual int solve_dynamic_system(const matrix_d& mat, const vector_d& vec, const vector_d& initial_condition)=0;
+
+        // thickness grid of the input file, with level_number rows
+        int set_table_grid(std::size_t level_number)
+        {
+            return init_table_grid(fTable,table_sampling(fvarmap),*fSummary,level_number);
+        }
+
+        double option_value(const std::string& key, double default_value) const
+        {
+            return numeric_option(fvarmap,key,default_value);
+        }
+    };
+}
+
+#endif	/* SOLVE_BEAR_EQUATIONS_BASE_H */
@@ -0,0 +1,58 @@
+/*
+ * File:   solve_bear_equations_rosenbrock.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef SOLVE_BEAR_EQUATIONS_ROSENBROCK_H
+#define	SOLVE_BEAR_EQUATIONS_ROSENBROCK_H
+
+#include "solve_bear_equations_base.h"
+#include "rosenbrock.h"
+
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    // solve policy for stiff systems : the equilibrium is obtained by LU solve, and
+    // the non-equilibrium solution is integrated with the L-stable Rosenbrock method
+    // on the thickness grid of the input file (no eigen decomposition)
+    template<typename T>
+    class solve_bear_equations_rosenbrock : public solve_bear_equations_base<T>
+    {
+        private:
+          typedef solve_bear_equations_base<T>                                     base_type;
+          typedef typename base_type::vector_d                                      vector_d;
+          typedef typename base_type::matrix_d                                      matrix_d;
+          rosenbrock<T> fIntegrator;
+    public:
+
+        solve_bear_equations_rosenbrock() : base_type(), fIntegrator()
+        {}
+        virtual ~solve_bear_equations_rosenbrock(){}
+
+    protected:
+        ////////////////////////////////////////////////////////////////////////////////////
+        // integrate dF/dx = AF + g on the thickness grid of the input file
+        int solve_dynamic_system(const matrix_d& mat, const vector_d& vec, const vector_d& initial_condition)
+        {
+            if(base_type::set_table_grid(mat.size1()+1))
+                return 1;
+
+            fIntegrator.set_tolerances(base_type::option_value("relative-tolerance",1.e-8),
+                                       base_type::option_value("absolute-tolerance",1.e-12));
+            if(fIntegrator.init(mat,vec) || fIntegrator.integrate(initial_condition,base_type::fTable))
+            {
+                LOG(ERROR)<<"Rosenbrock integration failed";
+                return 1;
+            }
+            LOG(INFO)<<"Number of steps = "<<fIntegrator.accepted_steps()
+                     <<" (rejected : "<<fIntegrator.rejected_steps()
+                     <<", LU factorizations : "<<fIntegrator.factorizations()<<")";
+            return 0;
+        }
+    };
+}
+
+#endif	/* SOLVE_BEAR_EQUATIONS_ROSENBROCK_H */
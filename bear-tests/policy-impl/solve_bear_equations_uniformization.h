@@ -0,0 +1,66 @@
+/*
+ * File:   solve_bear_equations_uniformization.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef SOLVE_BEAR_EQUATIONS_UNIFORMIZATION_H
+#define	SOLVE_BEAR_EQUATIONS_UNIFORMIZATION_H
+
+#include "solve_bear_equations_base.h"
+#include "uniformization.h"
+
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    // solve policy based on uniformization : the equilibrium is obtained by LU solve,
+    // and the non-equilibrium solution is propagated on the thickness grid of the
+    // input file with the full rate matrix M (dim N) of the system, rebuilt from A and g
+    // (no eigen decomposition)
+    template<typename T>
+    class solve_bear_equations_uniformization : public solve_bear_equations_base<T>
+    {
+        private:
+          typedef solve_bear_equations_base<T>                                     base_type;
+          typedef typename base_type::vector_d                                      vector_d;
+          typedef typename base_type::matrix_d                                      matrix_d;
+          uniformization<T> fIntegrator;
+    public:
+
+        solve_bear_equations_uniformization() : base_type(), fIntegrator()
+        {}
+        virtual ~solve_bear_equations_uniformization(){}
+
+    protected:
+        ////////////////////////////////////////////////////////////////////////////////////
+        // propagate dF/dx = MF on the thickness grid of the input file
+        int solve_dynamic_system(const matrix_d& mat, const vector_d& vec, const vector_d& initial_condition)
+        {
+            // rate matrix M (dim N) of the system, rebuilt from A and g
+            matrix_d M;
+            expand_system(mat,vec,M);
+            if(initial_condition.size()!=M.size1())
+            {
+                LOG(ERROR)<<"initial conditions do not match the dimension of the system (dim = "<<M.size1()<<")";
+                return 1;
+            }
+
+            if(base_type::set_table_grid(M.size1()))
+                return 1;
+
+            fIntegrator.set_tolerance(base_type::option_value("absolute-tolerance",1.e-12));
+            if(fIntegrator.init(M) || fIntegrator.integrate(initial_condition,base_type::fTable))
+            {
+                LOG(ERROR)<<"uniformization failed";
+                return 1;
+            }
+            LOG(INFO)<<"Uniformization rate = "<<fIntegrator.rate()
+                     <<", number of matrix-vector products = "<<fIntegrator.matvecs();
+            return 0;
+        }
+    };
+}
+
+#endif	/* SOLVE_BEAR_EQUATIONS_UNIFORMIZATION_H */
@@ -0,0 +1,121 @@
+/*
+ * File:   thickness_sampler.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef THICKNESS_SAMPLER_H
+#define	THICKNESS_SAMPLER_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "def.h"
+#include "thickness_table.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Adaptive thickness grid for a solution that can be evaluated at any x :     //
+    /// starting from a coarse log grid (fast transients near x=0, slow relaxation  //
+    /// at large x), each interval [a,b] is split at its (geometric) middle m as    //
+    /// long as the linear interpolation between a and b misses F(m) by more than   //
+    /// the tolerance (max over the levels). The number of points then follows the  //
+    /// local curvature instead of the range.                                       //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    class thickness_sampler
+    {
+        typedef T                                                              data_type;
+
+    public:
+        thickness_sampler() :   fTolerance(1.e-4), fInitial_points(32), fMax_points(1000000), fMax_depth(40),
+                                fLevels(0), fX(), fValues()
+        {}
+        virtual ~thickness_sampler(){}
+
+        void set_tolerance(data_type tolerance) { fTolerance=tolerance; }
+        void set_max_points(std::size_t max_points) { fMax_points=max_points; }
+
+        // the last sampling stopped at the max. number of points : the tolerance may not be reached
+        bool truncated() const { return fX.size()>=fMax_points; }
+
+        // evaluate(x,F) writes the N fractions F(x) in F
+        template<typename Evaluator>
+        int sample(Evaluator evaluate, data_type xmin, data_type xmax, std::size_t level_number, thickness_table<data_type>& table)
+        {
+            if(level_number==0 || !(xmax>xmin) || !(fTolerance>0.))
+                return 1;
+
+            thickness_table<data_type> coarse;
+            coarse.set_log_grid(xmin,xmax,fInitial_points,level_number);
+
+            fLevels=level_number;
+            fX.clear();
+            fValues.clear();
+
+            std::vector<data_type> Fa(level_number);
+            std::vector<data_type> Fb(level_number);
+            data_type a=coarse.x(0);
+            evaluate(a,&Fa[0]);
+            append(a,Fa);
+            for(std::size_t k(1); k<coarse.points(); k++)
+            {
+                data_type b=coarse.x(k);
+                evaluate(b,&Fb[0]);
+                refine(evaluate,a,Fa,b,Fb,0);
+                append(b,Fb);
+                a=b;
+                Fa.swap(Fb);
+            }
+
+            table.set_grid(fX,level_number);
+            std::copy(fValues.begin(),fValues.end(),table.column(0));
+            return 0;
+        }
+
+    private:
+        template<typename Evaluator>
+        void refine(Evaluator& evaluate, data_type a, const std::vector<data_type>& Fa, 
+                                         data_type b, const std::vector<data_type>& Fb, std::size_t depth)
+        {
+            if(depth>=fMax_depth || fX.size()>=fMax_points)
+                return;
+
+            data_type m = a>0. ? std::sqrt(a*b) : 0.5*(a+b);
+            if(!(m>a && m<b))
+                return;
+
+            std::vector<data_type> Fm(fLevels);
+            evaluate(m,&Fm[0]);
+            data_type t=(m-a)/(b-a);
+            data_type error=data_type();
+            for(std::size_t i(0); i<fLevels; i++)
+                error=std::max(error,std::abs(Fm[i]-(Fa[i]+t*(Fb[i]-Fa[i]))));
+            if(error<=fTolerance)
+                return;
+
+            refine(evaluate,a,Fa,m,Fm,depth+1);
+            append(m,Fm);
+            refine(evaluate,m,Fm,b,Fb,depth+1);
+        }
+
+        void append(data_type x, const std::vector<data_type>& F)
+        {
+            fX.push_back(x);
+            fValues.insert(fValues.end(),F.begin(),F.end());
+        }
+
+        data_type fTolerance;           // max. linear interpolation error
+        std::size_t fInitial_points;    // points of the initial log grid
+        std::size_t fMax_points;
+        std::size_t fMax_depth;
+        std::size_t fLevels;
+        std::vector<data_type> fX;
+        std::vector<data_type> fValues; // F(x_k) stored point after point
+    };
+}
+
+#endif	/* THICKNESS_SAMPLER_H */
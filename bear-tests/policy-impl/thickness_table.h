@@ -0,0 +1,140 @@
+/*
+ * File:   thickness_table.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef THICKNESS_TABLE_H
+#define	THICKNESS_TABLE_H
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+namespace bear
+{
+    namespace ublas = boost::numeric::ublas;
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    // charge state fractions F_i(x_k) tabulated on a thickness grid x_k,
+    // stored in a N x M column major matrix : column k = F(x_k) is contiguous
+    template<typename T>
+    class thickness_table
+    {
+    public:
+        typedef T                                                              data_type;
+        typedef ublas::matrix<data_type,ublas::column_major>                    matrix_d;
+
+        thickness_table() : fX(), fValues(), fUniform(false) {}
+        virtual ~thickness_table(){}
+
+        // uniform grid as in the table output : x_k = xmin + k*(xmax-xmin)/npoint, k=0..npoint-1
+        void set_uniform_grid(data_type xmin, data_type xmax, std::size_t npoint, std::size_t level_number)
+        {
+            fX.resize(npoint);
+            data_type step = npoint>0 ? (xmax-xmin)/data_type(npoint) : data_type();
+            for(std::size_t k(0); k<npoint; k++)
+                fX[k]=data_type(k)*step+xmin;
+            fValues.resize(level_number,npoint,false);
+            fUniform=true;
+        }
+
+        // logarithmic grid from xmin to xmax (both included). If xmin <= 0, x_0 = xmin and
+        // the other points are log spaced from xmin + (xmax-xmin)*1e-6 to xmax
+        void set_log_grid(data_type xmin, data_type xmax, std::size_t npoint, std::size_t level_number)
+        {
+            fX.resize(npoint);
+            if(npoint>0)
+            {
+                const std::size_t first = (xmin>0. || npoint==1) ? 0 : 1;
+                const data_type offset = first==0 ? data_type() : xmin;
+                const data_type xlow = first==0 ? xmin : (xmax-xmin)*1.e-6;
+                const std::size_t interval_number = npoint-first>1 ? npoint-first-1 : 1;
+                const data_type log_step=std::log((xmax-offset)/xlow)/data_type(interval_number);
+                fX[0]=xmin;
+                for(std::size_t k(first); k<npoint; k++)
+                    fX[k]=offset+xlow*std::exp(data_type(k-first)*log_step);
+                if(npoint>1)
+                    fX[npoint-1]=xmax;
+            }
+            fValues.resize(level_number,npoint,false);
+            fUniform=false;
+        }
+
+        // grid of the sampling option : "linear" (uniform grid) or "log". The "adaptive"
+        // sampling needs to evaluate the solution at any thickness (see thickness_sampler) :
+        // the solvers that can only step through a given grid use the log grid instead.
+        // return 1 if the sampling is unknown
+        int set_grid(const std::string& sampling, data_type xmin, data_type xmax, std::size_t npoint, std::size_t level_number)
+        {
+            if(sampling=="linear")
+                set_uniform_grid(xmin,xmax,npoint,level_number);
+            else if(sampling=="log" || sampling=="adaptive")
+                set_log_grid(xmin,xmax,npoint,level_number);
+            else
+                return 1;
+            return 0;
+        }
+
+        // arbitrary (increasing) grid
+        void set_grid(const std::vector<data_type>& x, std::size_t level_number)
+        {
+            fX=x;
+            fValues.resize(level_number,fX.size(),false);
+            fUniform=false;
+        }
+
+        void clear()
+        {
+            fX.clear();
+            fValues.resize(0,0,false);
+            fUniform=false;
+        }
+
+        std::size_t levels() const { return fValues.size1(); }
+        std::size_t points() const { return fX.size(); }
+        bool empty() const { return fX.empty() || fValues.size1()==0; }
+        bool uniform() const { return fUniform; }
+
+        // grid step, only meaningful for uniform grids
+        data_type step() const
+        {
+            return fX.size()>1 ? fX[1]-fX[0] : data_type();
+        }
+
+        // histogram bins : bin k starts at x_k, the last one has the width of the previous
+        // one (or width if there is a single point)
+        std::vector<data_type> bin_edges(data_type width) const
+        {
+            std::vector<data_type> edges(fX);
+            if(fX.size()>1)
+                width=fX[fX.size()-1]-fX[fX.size()-2];
+            if(!fX.empty())
+                edges.push_back(fX.back()+width);
+            return edges;
+        }
+
+        data_type x(std::size_t k) const { return fX[k]; }
+        const std::vector<data_type>& grid() const { return fX; }
+
+        data_type& operator()(std::size_t row, std::size_t k) { return fValues(row,k); }
+        data_type operator()(std::size_t row, std::size_t k) const { return fValues(row,k); }
+
+        // F(x_k), levels() contiguous values
+        data_type* column(std::size_t k) { return &fValues.data()[0]+k*fValues.size1(); }
+        const data_type* column(std::size_t k) const { return &fValues.data()[0]+k*fValues.size1(); }
+
+        matrix_d& values() { return fValues; }
+        const matrix_d& values() const { return fValues; }
+
+    private:
+        std::vector<data_type> fX;      // thickness grid (dim M)
+        matrix_d fValues;               // F_i(x_k) (dim N x M)
+        bool fUniform;
+    };
+}
+
+#endif	/* THICKNESS_TABLE_H */
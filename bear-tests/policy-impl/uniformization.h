@@ -0,0 +1,227 @@
+/*
+ * File:   uniformization.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef UNIFORMIZATION_H
+#define	UNIFORMIZATION_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+
+#include "def.h"
+#include "thickness_table.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Uniformization (randomization) of dF/dx = MF, with M the full rate matrix   //
+    /// (dim N) : off-diagonal elements are >= 0 and the columns sum to zero. With  //
+    /// Lambda = max |M(i,i)| and P = I + M/Lambda (column stochastic) :            //
+    ///                                                                             //
+    ///   F(x+dx) = Sum(n>=0) Poisson(n ; Lambda dx) P^n F(x)                       //
+    ///                                                                             //
+    /// The sum is truncated to [L,R] as in Fox & Glynn (1988) : the weights are    //
+    /// computed outward from the mode of the distribution (no under/overflow) and  //
+    /// both tails are bounded by geometric series, so that the dropped Poisson     //
+    /// mass is at most epsilon. Since P^n F stays a probability vector, the error  //
+    /// on the fractions is at most epsilon (L1 norm) per interval of the table,    //
+    /// and the solution stays non-negative. P is stored as a sparse matrix.        //
+    /// //////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    class uniformization
+    {
+        typedef T                                                              data_type;
+        typedef ublas::vector<data_type>                                        vector_d;
+        typedef ublas::matrix<data_type,ublas::column_major>                    matrix_d;
+        typedef ublas::compressed_matrix<data_type,ublas::column_major>  sparse_matrix_d;
+
+    public:
+        uniformization() :  fP(), fLambda(0.), fEpsilon(1.e-12),
+                            fLeft(0), fRight(0), fWeights(), fWeights_lambda(-1.),
+                            fMatvecs(0), fV(), fPv(), fSum()
+        {}
+        virtual ~uniformization(){}
+
+        // M : full rate matrix of the system
+        int init(const matrix_d& M)
+        {
+            if(M.size1()!=M.size2() || M.size1()==0)
+                return 1;
+            const std::size_t dim=M.size1();
+
+            fLambda=0.;
+            for(std::size_t i(0); i<dim; i++)
+            {
+                for(std::size_t j(0); j<dim; j++)
+                    if(i!=j && M(i,j)<0.)
+                    {
+                        LOG(ERROR)<<"Uniformization : negative rate M("<<i<<","<<j<<") = "<<M(i,j);
+                        return 1;
+                    }
+                fLambda=std::max(fLambda,std::abs(M(i,i)));
+            }
+
+            fP.resize(dim,dim,false);
+            fP.clear();
+            if(fLambda>0.)
+            {
+                // column-major fill : elements are appended in storage order
+                for(std::size_t j(0); j<dim; j++)
+                    for(std::size_t i(0); i<dim; i++)
+                    {
+                        data_type p = (i==j) ? 1.+M(i,i)/fLambda : M(i,j)/fLambda;
+                        if(p!=0.)
+                            fP.push_back(i,j,p);
+                    }
+            }
+
+            fWeights_lambda=-1.;
+            for(vector_d* v : {&fV, &fPv, &fSum})
+                v->resize(dim,false);
+            return 0;
+        }
+
+        // bound on the L1 error of the whole table
+        void set_tolerance(data_type epsilon)
+        {
+            fEpsilon=epsilon;
+        }
+
+        data_type rate() const { return fLambda; }
+        std::size_t matvecs() const { return fMatvecs; }
+
+        // propagate F(x=0)=F0 through the grid points of the table
+        int integrate(const vector_d& F0, thickness_table<data_type>& table)
+        {
+            const std::size_t dim=fP.size1();
+            fMatvecs=0;
+            if(table.empty())
+                return 0;
+            if(F0.size()!=dim || table.levels()!=dim || table.x(0)<0.)
+                return 1;
+
+            // the error budget is shared between the intervals of the table
+            const data_type epsilon=fEpsilon/data_type(table.points());
+
+            fV=F0;
+            data_type x=0.;
+            for(std::size_t k(0); k<table.points(); k++)
+            {
+                data_type dx=table.x(k)-x;
+                if(dx<0.)
+                    return 1;
+                if(dx>0. && fLambda>0.)
+                {
+                    if(weights(fLambda*dx,epsilon))
+                        return 1;
+                    propagate();
+                }
+                x=table.x(k);
+
+                data_type* F=table.column(k);
+                for(std::size_t i(0); i<dim; i++)
+                    F[i]=fV(i);
+            }
+            return 0;
+        }
+
+    private:
+        // fV <- Sum(n=L..R) w_n P^n fV
+        void propagate()
+        {
+            fSum.clear();
+            for(std::size_t n(0); n<=fRight; n++)
+            {
+                if(n>=fLeft)
+                    fSum+=fWeights[n-fLeft]*fV;
+                if(n<fRight)
+                {
+                    ublas::axpy_prod(fP,fV,fPv,true);
+                    fV.swap(fPv);
+                    ++fMatvecs;
+                }
+            }
+            fV.swap(fSum);
+        }
+
+        // Poisson weights of parameter lambda, truncated to [L,R] with a dropped mass <= epsilon
+        int weights(data_type lambda, data_type epsilon)
+        {
+            if(lambda==fWeights_lambda)
+                return 0;
+            if(!std::isfinite(lambda) || !(epsilon>0.))
+            {
+                LOG(ERROR)<<"Uniformization : invalid Poisson parameter "<<lambda<<" or tolerance "<<epsilon;
+                return 1;
+            }
+
+            const std::size_t mode=static_cast<std::size_t>(std::floor(lambda));
+            std::vector<data_type> right(1,1.);// weights relative to w(mode)
+            std::vector<data_type> left;
+            data_type total=1.;
+
+            // right tail : w(n+1)/w(n) = lambda/(n+1) decreases, so that
+            // Sum(m>n) w(m) <= w(n+1)/(1-lambda/(n+2))
+            for(std::size_t n(mode); ; n++)
+            {
+                data_type w=right.back()*lambda/data_type(n+1);
+                data_type tail=w/(1.-lambda/data_type(n+2));
+                if(tail<=0.5*epsilon*total)
+                    break;
+                right.push_back(w);
+                total+=w;
+            }
+
+            // left tail : w(n-1)/w(n) = n/lambda decreases as n decreases, so that
+            // Sum(m<n) w(m) <= w(n-1)/(1-(n-1)/lambda)
+            data_type w_n=1.;
+            for(std::size_t n(mode); n>0; n--)
+            {
+                data_type w=w_n*data_type(n)/lambda;
+                data_type tail=w/(1.-data_type(n-1)/lambda);
+                if(tail<=0.5*epsilon*total)
+                    break;
+                left.push_back(w);
+                total+=w;
+                w_n=w;
+            }
+
+            fLeft=mode-left.size();
+            fRight=mode+right.size()-1;
+            fWeights.resize(left.size()+right.size());
+            std::reverse_copy(left.begin(),left.end(),fWeights.begin());
+            std::copy(right.begin(),right.end(),fWeights.begin()+left.size());
+            for(auto& w : fWeights)
+                w/=total;
+
+            fWeights_lambda=lambda;
+            LOG(DEBUG)<<"Uniformization : Poisson("<<lambda<<") truncated to ["<<fLeft<<","<<fRight<<"]";
+            return 0;
+        }
+
+        sparse_matrix_d fP;                 // I + M/Lambda
+        data_type fLambda;                  // uniformization rate
+        data_type fEpsilon;
+        std::size_t fLeft;                  // Fox-Glynn truncation points
+        std::size_t fRight;
+        std::vector<data_type> fWeights;    // normalized Poisson weights on [L,R]
+        data_type fWeights_lambda;          // Poisson parameter of fWeights
+        std::size_t fMatvecs;
+
+        // work vectors
+        vector_d fV;
+        vector_d fPv;
+        vector_d fSum;
+    };
+}
+
+#endif	/* UNIFORMIZATION_H */
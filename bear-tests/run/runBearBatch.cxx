@@ -0,0 +1,219 @@
+/*
+ * File:   runBearBatch.cxx
+ *
+ * Created on October 17, 2026
+ */
+
+// solve the systems of many input files on a pool of threads (one process for all) :
+// bear-batch --inputs dir_or_file ... [--threads N] [bear options]
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <map>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+#include "equations_manager.h"
+#include "bear_equations.h"
+#include "solve_bear_equations.h"
+#include "bear_user_interface.h"
+#include "bear_table_output.h"
+#include "io_utils.h"
+#include "logger.h"
+
+#include "def.h"
+
+using namespace bear;
+
+typedef bear_equations<double> equations_d;
+typedef solve_bear_equations<double> solve_method_d;
+typedef equations_manager<double,equations_d,solve_method_d,bear_table_output> bear_manager;
+
+// outcome of one input file, reported in the summary
+struct batch_result
+{
+    batch_result() : input(), status(1), levels(0), charge_min(0), charge_max(0),
+                     mean_charge(0.), max_fraction_charge(0), seconds(0.), output()
+    {}
+    fs::path input;
+    int status;
+    std::size_t levels;
+    int charge_min;
+    int charge_max;
+    double mean_charge;         // <q> at equilibrium
+    int max_fraction_charge;    // charge of the max. initial fraction
+    double seconds;
+    std::string output;         // results file (empty if not saved)
+};
+
+// the results files are named after the stems of the input files : two input files with the
+// same stem (e.g. in different directories) would write the same results files
+int check_output_names(const std::vector<fs::path>& inputs)
+{
+    std::map<std::string,fs::path> stems;
+    for(const auto& input : inputs)
+    {
+        auto inserted=stems.insert(std::make_pair(input.stem().string(),input));
+        if(!inserted.second)
+        {
+            LOG(ERROR)<<"the input files "<<inserted.first->second.string()<<" and "<<input.string()
+                      <<" have the same name : their results files would overwrite each other";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// init, run and save one input file with the options of the batch
+void solve(const po::variables_map& vm, batch_result& result)
+{
+    auto start=std::chrono::steady_clock::now();
+    try
+    {
+        bear_manager man;
+        if(!man.set_input(vm,result.input) && !man.init() && !man.run())
+        {
+            result.status=0;
+            if(vm.at("save").as<bool>())
+                result.status=man.save();
+        }
+
+        const bear_summary& summary=man.get_summary();
+        result.levels=summary.system_dim;
+        if(result.status==0 && vm.at("save").as<bool>())
+            result.output=summary.outfilename;
+        if(!summary.F_index_map.empty())
+        {
+            result.charge_min=summary.F_index_map.begin()->second;
+            result.charge_max=summary.F_index_map.rbegin()->second;
+            if(summary.F_index_map.count(summary.max_fraction_index))
+                result.max_fraction_charge=summary.F_index_map.at(summary.max_fraction_index);
+        }
+        for(const auto& p : summary.equilibrium_solutions)
+            result.mean_charge+=summary.F_index_map.at(p.first)*p.second;
+    }
+    catch(std::exception& e)
+    {
+        LOG(ERROR)<<result.input.string()<<" : "<<e.what();
+        result.status=1;
+    }
+    result.seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+}
+
+// one row per input file, in the order of the inputs
+int write_summary(const std::string& filename, const std::vector<batch_result>& results)
+{
+    std::ofstream file(filename.c_str(),std::ios::out|std::ios::trunc);
+    file<<"input,status,levels,charge_min,charge_max,mean_charge,max_fraction_charge,seconds,output\n";
+    for(const auto& r : results)
+        file<<csv_quoted(r.input.string())<<","
+            <<(r.status ? "error" : "ok")<<","
+            <<r.levels<<","
+            <<r.charge_min<<","
+            <<r.charge_max<<","
+            <<csv_number(r.mean_charge)<<","
+            <<r.max_fraction_charge<<","
+            <<csv_number(r.seconds)<<","
+            <<csv_quoted(r.output)<<"\n";
+    return file ? 0 : 1;
+}
+
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        init_log_console(bear::severity_level::INFO,log_op::operation::GREATER_EQ_THAN);
+        LOG(STATE)<<"start BEAR batch : Ballance Equations for Atomic Reactions";
+
+        /// /////////////////////////////////////////////////////
+        // PARSE OPTIONS : batch options, then the bear options shared by all the input files
+        std::size_t hardware_threads=std::max(1u,std::thread::hardware_concurrency());
+        po::options_description batch_desc("batch options");
+        batch_desc.add_options()
+            ("inputs",      po::value<std::vector<std::string> >()->multitoken(),           "input files, or directories (all their .txt files)")
+            ("threads",     po::value<std::size_t>()->default_value(hardware_threads),      "number of threads")
+            ("summary",     po::value<std::string>()->default_value("bear-batch-summary.csv"), "summary file (csv, in the output directory)")
+        ;
+        po::variables_map batch_vm;
+        po::store(po::command_line_parser(argc,argv).options(batch_desc).allow_unregistered().run(),batch_vm);
+        po::notify(batch_vm);
+
+        bear_manager options;
+        options.use_cfgFile();
+        options.set_input_required(false);
+        // the solvers of all the threads log together : only warnings and errors by default
+        options.set_default_verbosity("WARN");
+        if(options.parse(argc, argv,true))
+        {
+            std::cout<<batch_desc<<std::endl;
+            return 1;
+        }
+        const po::variables_map& vm=options.get_varMap();
+
+        std::vector<fs::path> inputs;
+        if(batch_vm.count("inputs") && collect_inputs(batch_vm["inputs"].as<std::vector<std::string> >(),inputs))
+            return 1;
+        if(inputs.empty())
+        {
+            LOG(ERROR)<<"no input file (--inputs file_or_directory ...)";
+            return 1;
+        }
+        if(check_output_names(inputs))
+            return 1;
+
+        /// /////////////////////////////////////////////////////
+        // SOLVE : each thread takes the next input file until there is none left
+        std::vector<batch_result> results(inputs.size());
+        for(std::size_t i(0); i<inputs.size(); i++)
+            results[i].input=inputs[i];
+
+        std::size_t thread_number=std::max<std::size_t>(1,std::min(batch_vm["threads"].as<std::size_t>(),inputs.size()));
+        LOG(STATE)<<"solving "<<inputs.size()<<" input files with "<<thread_number<<" threads ...";
+        auto start=std::chrono::steady_clock::now();
+
+        std::atomic<std::size_t> next(0);
+        auto worker=[&]()
+        {
+            for(std::size_t i=next++; i<results.size(); i=next++)
+            {
+                solve(vm,results[i]);
+                if(results[i].status)
+                    LOG(ERROR)<<"failed to solve "<<results[i].input.string();
+            }
+        };
+        std::vector<std::thread> threads;
+        for(std::size_t t(1); t<thread_number; t++)
+            threads.emplace_back(worker);
+        worker();
+        for(auto& thread : threads)
+            thread.join();
+
+        double seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+        /// /////////////////////////////////////////////////////
+        // SUMMARY
+        std::size_t failed=std::count_if(results.begin(),results.end(),[](const batch_result& r){ return r.status!=0; });
+        std::string summary=vm["output-directory"].as<fs::path>().string()+"/"+batch_vm["summary"].as<std::string>();
+        if(write_summary(summary,results))
+        {
+            LOG(ERROR)<<"could not write the summary "<<summary;
+            return 1;
+        }
+        LOG(STATE)<<"solved "<<inputs.size()-failed<<"/"<<inputs.size()<<" input files in "<<seconds<<" s";
+        LOG(STATE)<<"- summary : "<<summary;
+        if(failed)
+            return 1;
+    }
+    catch(std::exception& e)
+    {
+        LOG(ERROR) << e.what();
+        return 1;
+    }
+
+    LOG(INFO)<<"Execution successful!";
+    return 0;
+}
@@ -0,0 +1,740 @@
+/*
+ * File:   runBearServe.cxx
+ *
+ * Created on October 17, 2026
+ */
+
+// long-running solver : one JSON request per line, one JSON response per line,
+// on the standard input/output or on the connections of a local Unix socket :
+// bear-serve [--socket path] [--max-connections N] [--cache-size N] [bear options]
+
+#include <set>
+#include <map>
+#include <list>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <cstring>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "bear_equations.h"
+#include "bear_user_interface.h"
+#include "bear_core.h"
+#include "io_utils.h"
+#include "units.h"
+#include "logger.h"
+
+#include "def.h"
+
+using namespace bear;
+
+typedef bear_equations<double> equations_d;
+typedef boost::property_tree::ptree ptree;
+
+/// //////////////////////////////////////////////////////////////////////////////////
+/// JSON output                                                                       //
+/// //////////////////////////////////////////////////////////////////////////////////
+
+template<typename Iterator>
+std::string json_array(Iterator begin, Iterator end)
+{
+    std::string array="[";
+    for(Iterator it=begin; it!=end; ++it)
+        array+=(it==begin ? "" : ",")+json_number(*it);
+    return array+"]";
+}
+
+std::string json_array(const std::vector<int>& values)
+{
+    std::string array="[";
+    for(std::size_t i(0); i<values.size(); i++)
+        array+=(i ? "," : "")+std::to_string(values[i]);
+    return array+"]";
+}
+
+// F(x_k) of the table, one array per point
+std::string json_columns(const thickness_table<double>& table)
+{
+    std::string array="[";
+    for(std::size_t k(0); k<table.points(); k++)
+        array+=(k ? "," : "")+json_array(table.column(k),table.column(k)+table.levels());
+    return array+"]";
+}
+
+
+/// //////////////////////////////////////////////////////////////////////////////////
+/// Request handler : the problems are solved with the reentrant core (bear_solve),  //
+/// and two caches keep the work of the previous requests :                          //
+///   - the input files already read (bear_problem), until they are modified        //
+///   - the solved systems (bear_result), by cross-sections and method : a request  //
+///     that only changes the initial conditions, the thickness grid or the outputs //
+///     reuses the decomposition, its initial conditions are projected on it        //
+///     (bear_reproject)                                                            //
+/// The requests of several connections are handled in parallel, the caches are     //
+/// shared under a mutex, the solves are done outside of it.                        //
+/// //////////////////////////////////////////////////////////////////////////////////
+class bear_server
+{
+    // an input file is read again when its modification time (ns) or its size change
+    struct cached_input
+    {
+        long long mtime;
+        off_t size;
+        bear_problem problem;
+    };
+
+public:
+    bear_server(const po::variables_map& vm, std::size_t cache_size) :
+                                fVarmap(vm), fCache_size(cache_size), fMutex(), fInputs(), fInput_order(), fResults(), fResult_order(),
+                                fRequests(0), fInput_hits(0), fResult_hits(0), fStopped(false)
+    {}
+    virtual ~bear_server(){}
+
+    bool stopped() const { return fStopped; }
+
+    // response to one request line (without newline)
+    std::string handle(const std::string& line)
+    {
+        ++fRequests;
+        ptree request;
+        try
+        {
+            std::istringstream stream(line);
+            boost::property_tree::read_json(stream,request);
+        }
+        catch(std::exception& e)
+        {
+            return error_response("",std::string("invalid request : ")+e.what());
+        }
+
+        // the id is sent back with its JSON type (string or number)
+        std::string id;
+        if(request.count("id"))
+            id=json_id(line,request.get<std::string>("id"));
+
+        try
+        {
+            std::string command=request.get<std::string>("command","solve");
+            if(command=="solve")
+                return solve_response(id,request);
+            if(command=="stats")
+                return stats_response(id);
+            if(command=="shutdown")
+            {
+                fStopped=true;
+                return response(id)+"}";
+            }
+            return error_response(id,"unknown command '"+command+"' (solve, stats or shutdown)");
+        }
+        catch(std::exception& e)
+        {
+            return error_response(id,e.what());
+        }
+    }
+
+private:
+    // JSON text of the id of the request line : the parsed tree keeps only its string value,
+    // thus the type is the one of the raw value of the top-level "id" key (a string stays
+    // a string, a number or literal is sent back as is)
+    static std::string json_id(const std::string& line, const std::string& value)
+    {
+        int depth=0;
+        for(std::size_t pos(0); pos<line.size(); pos++)
+        {
+            const char c=line[pos];
+            if(c=='{' || c=='[')
+                depth++;
+            else if(c=='}' || c==']')
+                depth--;
+            else if(c=='"')
+            {
+                std::size_t end=pos+1;
+                while(end<line.size() && line[end]!='"')
+                    end+= line[end]=='\\' ? 2 : 1;
+                const bool id_key= depth==1 && line.compare(pos,end-pos+1,"\"id\"")==0;
+                pos=end;
+                if(!id_key)
+                    continue;
+                std::size_t next=line.find_first_not_of(" \t\r",pos+1);
+                if(next==std::string::npos || line[next]!=':')
+                    continue;
+                next=line.find_first_not_of(" \t\r",next+1);
+                if(next!=std::string::npos && line[next]!='"')
+                    return value.empty() ? "null" : value;
+                break;
+            }
+        }
+        return json_string(value);
+    }
+
+    std::string response(const std::string& id, const std::string& status="ok")
+    {
+        std::string str="{";
+        if(!id.empty())
+            str+="\"id\":"+id+",";
+        return str+"\"status\":"+json_string(status);
+    }
+
+    std::string error_response(const std::string& id, const std::string& error)
+    {
+        LOG(WARN)<<"request "<<fRequests<<" : "<<error;
+        return response(id,"error")+",\"error\":"+json_string(error)+"}";
+    }
+
+    std::string stats_response(const std::string& id)
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        return response(id)
+                +",\"requests\":"+std::to_string(fRequests)
+                +",\"cached_inputs\":"+std::to_string(fInputs.size())
+                +",\"input_hits\":"+std::to_string(fInput_hits)
+                +",\"cached_results\":"+std::to_string(fResults.size())
+                +",\"result_hits\":"+std::to_string(fResult_hits)+"}";
+    }
+
+    std::string solve_response(const std::string& id, const ptree& request)
+    {
+        bear_problem problem;
+        std::string error;
+        if(read_problem(request,problem,error))
+            return error_response(id,error);
+
+        bool cached=false;
+        std::shared_ptr<const bear_result> result=solve(problem,cached);
+        if(result->status())
+            return error_response(id,result->error());
+
+        // outputs wanted : equilibrium and mean charge by default, F at the thicknesses x
+        std::set<std::string> outputs;
+        if(request.count("outputs"))
+            for(const auto& p : request.get_child("outputs"))
+                outputs.insert(p.second.get_value<std::string>());
+        else
+            outputs={"equilibrium","mean_charge"};
+
+        std::string str=response(id);
+        str+=",\"cached\":"+std::string(cached ? "true" : "false");
+        str+=",\"charge_states\":"+json_array(result->charge_states());
+        for(const auto& output : outputs)
+        {
+            if(output=="equilibrium")
+                str+=",\"equilibrium\":"+json_array(result->equilibrium().begin(),result->equilibrium().end());
+            else if(output=="mean_charge")
+                str+=",\"mean_charge\":"+json_number(result->mean_charge());
+            else if(output=="table")
+            {
+                thickness_table<double> table;
+                if(!result->dynamic())
+                    return error_response(id,"the table needs initial conditions");
+                if(result->tabulate(problem.sampling,problem.thickness_minimum,problem.thickness_maximum,
+                                    problem.thickness_point_number,table,problem.sampling_tolerance))
+                    return error_response(id,"could not tabulate the solution on the thickness grid");
+                str+=",\"table\":{\"x\":"+json_array(table.grid().begin(),table.grid().end())
+                                +",\"F\":"+json_columns(table)+"}";
+            }
+            else
+                return error_response(id,"unknown output '"+output+"' (equilibrium, mean_charge or table)");
+        }
+
+        std::vector<double> x;
+        if(request.count("x"))
+        {
+            for(const auto& p : request.get_child("x"))
+                x.push_back(p.second.get_value<double>());
+            if(result->dynamic())
+            {
+                thickness_table<double> table;
+                table.set_grid(x,result->levels());
+                ublas::vector<double> F;
+                for(std::size_t k(0); k<x.size(); k++)
+                {
+                    if(result->eval(x[k],F))
+                        return error_response(id,"could not evaluate F(x)");
+                    std::copy(F.begin(),F.end(),table.column(k));
+                }
+                str+=",\"x\":"+json_array(x.begin(),x.end())+",\"F\":"+json_columns(table);
+            }
+            else if(!result->scan_size())
+                return error_response(id,"F(x) needs initial conditions");
+        }
+
+        // parameter scan : one table per initial condition, at the thicknesses x if given,
+        // otherwise on the thickness grid
+        if(result->scan_size())
+        {
+            std::vector<thickness_table<double> > tables;
+            if(request.count("x") ? result->tabulate_scan(x,tables)
+                                  : result->tabulate_scan(problem.sampling,problem.thickness_minimum,problem.thickness_maximum,
+                                                          problem.thickness_point_number,tables))
+                return error_response(id,"could not tabulate the scan on the thickness grid");
+            str+=",\"scan\":{\"x\":"+json_array(tables[0].grid().begin(),tables[0].grid().end())+",\"F\":[";
+            for(std::size_t j(0); j<tables.size(); j++)
+                str+=(j ? "," : "")+json_columns(tables[j]);
+            str+="]}";
+        }
+        return str+"}";
+    }
+
+    // problem of the request : an input file, or the cross-sections of the request, then
+    // the initial conditions, method and thickness grid of the request if given
+    int read_problem(const ptree& request, bear_problem& problem, std::string& error)
+    {
+        if(request.count("input"))
+        {
+            if(load_input(request.get<std::string>("input"),problem,error))
+                return 1;
+        }
+        else if(request.count("cross_sections"))
+        {
+            std::vector<std::vector<double> > rows;
+            for(const auto& row : request.get_child("cross_sections"))
+            {
+                rows.push_back(std::vector<double>());
+                for(const auto& p : row.second)
+                    rows.back().push_back(p.second.get_value<double>());
+            }
+            std::size_t dim=rows.size();
+            for(const auto& row : rows)
+                if(row.size()!=dim)
+                {
+                    error="the cross-section matrix must be square (one row per charge state)";
+                    return 1;
+                }
+
+            // cross-sections per unit thickness : scale factor given, or from the units
+            double factor=request.get<double>("scale_factor",1.);
+            if(request.count("units"))
+            {
+                const ptree& units=request.get_child("units");
+                std::string cs_unit=units.get<std::string>("cross_section","cm2");
+                std::string x_unit=units.get<std::string>("thickness","mug/cm2");
+                if(scale_factor(cs_unit,x_unit,units.get<double>("target_mass"),factor))
+                {
+                    error="unknown unit '"+cs_unit+"' or '"+x_unit+"'";
+                    return 1;
+                }
+            }
+
+            int charge_min=request.get<int>("charge_min",0);
+            problem.charge_states.resize(dim);
+            problem.cross_sections.resize(dim,dim,false);
+            for(std::size_t i(0); i<dim; i++)
+            {
+                problem.charge_states[i]=charge_min+static_cast<int>(i);
+                for(std::size_t j(0); j<dim; j++)
+                    problem.cross_sections(i,j)= i==j ? 0. : rows[i][j]*factor;
+            }
+            problem.initial_condition.resize(0,false);
+        }
+        else
+        {
+            error="no 'input' file nor 'cross_sections' in the request";
+            return 1;
+        }
+
+        if(request.count("initial_condition"))
+        {
+            std::vector<double> F0;
+            for(const auto& p : request.get_child("initial_condition"))
+                F0.push_back(p.second.get_value<double>());
+            if(F0.size()!=problem.charge_states.size())
+            {
+                error="the initial conditions do not match the number of charge states";
+                return 1;
+            }
+            problem.initial_condition.resize(F0.size(),false);
+            std::copy(F0.begin(),F0.end(),problem.initial_condition.begin());
+        }
+
+        // parameter scan : K initial conditions solved with the same decomposition
+        if(request.count("initial_conditions"))
+        {
+            const std::size_t dim=problem.charge_states.size();
+            std::vector<std::vector<double> > F0s;
+            for(const auto& row : request.get_child("initial_conditions"))
+            {
+                F0s.push_back(std::vector<double>());
+                for(const auto& p : row.second)
+                    F0s.back().push_back(p.second.get_value<double>());
+                if(F0s.back().size()!=dim)
+                {
+                    error="the initial conditions of the scan do not match the number of charge states";
+                    return 1;
+                }
+            }
+            problem.initial_conditions.resize(dim,F0s.size(),false);
+            for(std::size_t j(0); j<F0s.size(); j++)
+                std::copy(F0s[j].begin(),F0s[j].end(),ublas::column(problem.initial_conditions,j).begin());
+        }
+
+        std::string method=request.get<std::string>("method",problem.propagator ? "propagator" : "diagonalization");
+        if(method!="diagonalization" && method!="propagator")
+        {
+            error="unknown method '"+method+"' (diagonalization or propagator)";
+            return 1;
+        }
+        problem.propagator = method=="propagator";
+
+        if(request.count("thickness"))
+        {
+            const ptree& grid=request.get_child("thickness");
+            problem.thickness_minimum=grid.get<double>("minimum",problem.thickness_minimum);
+            problem.thickness_maximum=grid.get<double>("maximum",problem.thickness_maximum);
+            problem.thickness_point_number=grid.get<std::size_t>("point_number",problem.thickness_point_number);
+            problem.sampling=grid.get<std::string>("sampling",problem.sampling);
+            problem.sampling_tolerance=grid.get<double>("tolerance",problem.sampling_tolerance);
+        }
+        return 0;
+    }
+
+    // input file read once, then from the cache until its modification time or size change
+    int load_input(const std::string& filename, bear_problem& problem, std::string& error)
+    {
+        fs::path path(filename);
+        struct stat status;
+        if(::stat(filename.c_str(),&status)!=0 || !S_ISREG(status.st_mode))
+        {
+            error="input file '"+filename+"' not found";
+            return 1;
+        }
+        const long long mtime=static_cast<long long>(status.st_mtim.tv_sec)*1000000000LL+status.st_mtim.tv_nsec;
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            auto it=fInputs.find(filename);
+            if(it!=fInputs.end() && it->second.mtime==mtime && it->second.size==status.st_size)
+            {
+                ++fInput_hits;
+                problem=it->second.problem;
+                return 0;
+            }
+        }
+
+        equations_d equations;
+        equations.init_summary(std::make_shared<bear_summary>());
+        if(equations.set_input(fVarmap,path) || equations.init() || equations.get_problem(problem))
+        {
+            error="could not read the input file '"+filename+"'";
+            return 1;
+        }
+
+        // the oldest input files are dropped first, a modified file keeps its place
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto inserted=fInputs.insert(std::make_pair(filename,cached_input{mtime,status.st_size,problem}));
+        if(!inserted.second)
+            inserted.first->second=cached_input{mtime,status.st_size,problem};
+        else
+        {
+            fInput_order.push_back(filename);
+            if(fInput_order.size()>fCache_size)
+            {
+                fInputs.erase(fInput_order.front());
+                fInput_order.pop_front();
+            }
+        }
+        return 0;
+    }
+
+    // the cross-sections and method define the decomposition (not the initial conditions
+    // nor the grid)
+    static std::string key(const bear_problem& problem)
+    {
+        std::string key(problem.propagator ? "P" : "D");
+        auto append=[&key](const void* data, std::size_t size)
+        {
+            key.append(static_cast<const char*>(data),size);
+        };
+        std::size_t dim=problem.charge_states.size();
+        append(&dim,sizeof(dim));
+        append(problem.charge_states.data(),dim*sizeof(int));
+        if(!problem.cross_sections.data().empty())
+            append(&problem.cross_sections.data()[0],problem.cross_sections.data().size()*sizeof(double));
+        return key;
+    }
+
+    template<typename E>
+    static bool same(const E& a, const E& b)
+    {
+        return a.data().size()==b.data().size() && std::equal(a.data().begin(),a.data().end(),b.data().begin());
+    }
+
+    // cached result with the initial conditions of the problem : the result itself if they
+    // are the same, otherwise they are projected on its decomposition
+    static std::shared_ptr<const bear_result> reproject(const std::shared_ptr<const bear_result>& result, const bear_problem& problem)
+    {
+        if(same(result->initial_condition(),problem.initial_condition)
+           && result->scan_initial_conditions().size2()==problem.initial_conditions.size2()
+           && same(result->scan_initial_conditions(),problem.initial_conditions))
+            return result;
+        return std::make_shared<bear_result>(bear_reproject(*result,problem));
+    }
+
+    std::shared_ptr<const bear_result> solve(const bear_problem& problem, bool& cached)
+    {
+        // a result solved without initial conditions has no decomposition : it only serves
+        // the problems without initial conditions
+        const bool projectable=!problem.initial_condition.empty() || problem.initial_conditions.size2()>0;
+        std::string problem_key=key(problem);
+        std::shared_ptr<const bear_result> result;
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            auto it=fResults.find(problem_key);
+            if(it!=fResults.end() && (it->second->projectable() || !projectable))
+            {
+                ++fResult_hits;
+                result=it->second;
+            }
+        }
+        if(result)
+        {
+            cached=true;
+            return reproject(result,problem);
+        }
+
+        cached=false;
+        result=std::make_shared<bear_result>(bear_solve(problem));
+        if(result->status())
+            return result;
+
+        // the oldest results are dropped first, a result with a decomposition replaces the
+        // one of the same system without
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto inserted=fResults.insert(std::make_pair(problem_key,result));
+        if(!inserted.second)
+        {
+            if(!inserted.first->second->projectable())
+                inserted.first->second=result;
+        }
+        else
+        {
+            fResult_order.push_back(problem_key);
+            if(fResult_order.size()>fCache_size)
+            {
+                fResults.erase(fResult_order.front());
+                fResult_order.pop_front();
+            }
+        }
+        return result;
+    }
+
+    po::variables_map fVarmap;          // bear options of the command line, shared by the input files
+    std::size_t fCache_size;            // max. number of input files and of results kept
+    std::mutex fMutex;
+    std::map<std::string,cached_input> fInputs;
+    std::deque<std::string> fInput_order;
+    std::map<std::string,std::shared_ptr<const bear_result> > fResults;
+    std::deque<std::string> fResult_order;
+    std::atomic<std::size_t> fRequests;
+    std::size_t fInput_hits;
+    std::size_t fResult_hits;
+    std::atomic<bool> fStopped;
+};
+
+
+/// //////////////////////////////////////////////////////////////////////////////////
+/// transports                                                                        //
+/// //////////////////////////////////////////////////////////////////////////////////
+
+// requests of the standard input, until its end or a shutdown command
+void serve_stdin(bear_server& server)
+{
+    std::string line;
+    while(!server.stopped() && std::getline(std::cin,line))
+        if(line.find_first_not_of(" \t\r")!=std::string::npos)
+            std::cout<<server.handle(line)<<std::endl;
+}
+
+int write_all(int fd, const std::string& str)
+{
+    std::size_t written=0;
+    while(written<str.size())
+    {
+        ssize_t n=::send(fd,str.data()+written,str.size()-written,MSG_NOSIGNAL);
+        if(n<=0)
+            return 1;
+        written+=static_cast<std::size_t>(n);
+    }
+    return 0;
+}
+
+// requests of one connection, until the client closes it
+void serve_client(bear_server& server, int fd)
+{
+    std::string buffer;
+    char data[65536];
+    ssize_t n;
+    while((n=::recv(fd,data,sizeof(data),0))>0)
+    {
+        buffer.append(data,static_cast<std::size_t>(n));
+        std::size_t begin=0;
+        std::size_t end;
+        while((end=buffer.find('\n',begin))!=std::string::npos)
+        {
+            std::string line=buffer.substr(begin,end-begin);
+            begin=end+1;
+            if(line.find_first_not_of(" \t\r")==std::string::npos)
+                continue;
+            if(write_all(fd,server.handle(line)+"\n"))
+                return;
+        }
+        buffer.erase(0,begin);
+    }
+}
+
+// connection served by its own thread, joined once done
+struct connection
+{
+    std::thread thread;
+    std::shared_ptr<std::atomic<bool> > done;
+};
+
+// connections of the Unix socket, each one served by its own thread, until a shutdown command.
+// At most max_connections are served at once, the next ones wait in the listen queue
+int serve_socket(bear_server& server, const std::string& socket_path, std::size_t max_connections)
+{
+    sockaddr_un address;
+    if(socket_path.size()>=sizeof(address.sun_path))
+    {
+        LOG(ERROR)<<"socket path '"<<socket_path<<"' is too long";
+        return 1;
+    }
+    std::memset(&address,0,sizeof(address));
+    address.sun_family=AF_UNIX;
+    std::strncpy(address.sun_path,socket_path.c_str(),sizeof(address.sun_path)-1);
+
+    // a socket left by a previous server is replaced, any other file is kept
+    struct stat status;
+    if(::stat(socket_path.c_str(),&status)==0)
+    {
+        if(!S_ISSOCK(status.st_mode))
+        {
+            LOG(ERROR)<<"'"<<socket_path<<"' exists and is not a socket";
+            return 1;
+        }
+        ::unlink(socket_path.c_str());
+    }
+
+    int server_fd=::socket(AF_UNIX,SOCK_STREAM,0);
+    if(server_fd<0 || ::bind(server_fd,reinterpret_cast<sockaddr*>(&address),sizeof(address))<0 || ::listen(server_fd,16)<0)
+    {
+        LOG(ERROR)<<"could not listen on socket '"<<socket_path<<"'";
+        if(server_fd>=0)
+            ::close(server_fd);
+        return 1;
+    }
+    LOG(STATE)<<"listening on "<<socket_path;
+
+    std::mutex client_mutex;
+    std::set<int> clients;
+    std::list<connection> connections;
+    while(!server.stopped())
+    {
+        // the threads of the closed connections are joined
+        for(auto it=connections.begin(); it!=connections.end();)
+            if(*it->done)
+            {
+                it->thread.join();
+                it=connections.erase(it);
+            }
+            else
+                ++it;
+
+        pollfd pfd={server_fd,POLLIN,0};
+        if(::poll(&pfd,connections.size()<max_connections ? 1 : 0,200)<=0)
+            continue;
+        int fd=::accept(server_fd,nullptr,nullptr);
+        if(fd<0)
+            continue;
+        std::lock_guard<std::mutex> lock(client_mutex);
+        clients.insert(fd);
+        std::shared_ptr<std::atomic<bool> > done=std::make_shared<std::atomic<bool> >(false);
+        connections.push_back(connection{std::thread([&server,&client_mutex,&clients,fd,done]()
+        {
+            serve_client(server,fd);
+            std::lock_guard<std::mutex> lock(client_mutex);
+            clients.erase(fd);
+            ::close(fd);
+            *done=true;
+        }),done});
+    }
+
+    // the connections still open are closed on shutdown
+    {
+        std::lock_guard<std::mutex> lock(client_mutex);
+        for(int fd : clients)
+            ::shutdown(fd,SHUT_RDWR);
+    }
+    for(auto& client : connections)
+        client.thread.join();
+    ::close(server_fd);
+    ::unlink(socket_path.c_str());
+    return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        init_log_console(bear::severity_level::INFO,log_op::operation::GREATER_EQ_THAN);
+        LOG(STATE)<<"start BEAR server : Ballance Equations for Atomic Reactions";
+
+        /// /////////////////////////////////////////////////////
+        // PARSE OPTIONS : server options, then the bear options used to read the input files
+        po::options_description serve_desc("server options");
+        serve_desc.add_options()
+            ("socket",      po::value<std::string>(),                               "Unix socket path (default : standard input and output)")
+            ("cache-size",  po::value<std::size_t>()->default_value(64),            "max. number of input files and of solved systems kept")
+            ("max-connections", po::value<std::size_t>()->default_value(64),        "max. number of connections of the socket served at once")
+        ;
+        po::variables_map serve_vm;
+        po::store(po::command_line_parser(argc,argv).options(serve_desc).allow_unregistered().run(),serve_vm);
+        po::notify(serve_vm);
+
+        equations_d options;
+        options.use_cfgFile();
+        options.set_input_required(false);
+        // the responses are the output : only warnings and errors by default
+        options.set_default_verbosity("WARN");
+        if(options.parse(argc, argv,true))
+        {
+            std::cout<<serve_desc<<std::endl;
+            return 1;
+        }
+        const po::variables_map& vm=options.get_varMap();
+
+        bear_server server(vm,std::max<std::size_t>(1,serve_vm["cache-size"].as<std::size_t>()));
+
+        if(serve_vm.count("socket"))
+        {
+            if(serve_socket(server,serve_vm["socket"].as<std::string>(),
+                            std::max<std::size_t>(1,serve_vm["max-connections"].as<std::size_t>())))
+                return 1;
+        }
+        else
+            serve_stdin(server);
+    }
+    catch(std::exception& e)
+    {
+        LOG(ERROR) << e.what();
+        return 1;
+    }
+
+    LOG(INFO)<<"Execution successful!";
+    return 0;
+}
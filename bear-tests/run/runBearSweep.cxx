@@ -0,0 +1,221 @@
+/*
+ * File:   runBearSweep.cxx
+ *
+ * Created on October 17, 2026
+ */
+
+// solve a sweep of systems in order (e.g. energies, targets, densities), reusing the
+// decomposition of the previous points when a point only rescales their cross-sections :
+// bear-sweep --inputs dir_or_file ... [--scale-factors s ...] [bear options]
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+#include "bear_equations.h"
+#include "bear_user_interface.h"
+#include "bear_sweep.h"
+#include "io_utils.h"
+#include "logger.h"
+
+#include "def.h"
+
+using namespace bear;
+
+typedef bear_equations<double> equations_d;
+
+// outcome of one point of the sweep, reported in the summary
+struct sweep_point
+{
+    sweep_point() : input(), scale_factor(1.), rescaled(false), status(1), levels(0), charge_min(0), charge_max(0),
+                    mean_charge(0.), max_fraction_charge(0), equilibrium(), seconds(0.)
+    {}
+    fs::path input;
+    double scale_factor;        // factor of the cross-sections of the input file
+    bool rescaled;              // solved from the decomposition of a previous point
+    int status;
+    std::size_t levels;
+    int charge_min;
+    int charge_max;
+    double mean_charge;         // <q> at equilibrium
+    int max_fraction_charge;    // charge of the max. initial fraction
+    std::vector<double> equilibrium;
+    double seconds;
+};
+
+// system of one input file, with the options of the sweep
+int read_problem(const po::variables_map& vm, const fs::path& input, bear_problem& problem)
+{
+    equations_d equations;
+    equations.init_summary(std::make_shared<bear_summary>());
+    if(equations.set_input(vm,input) || equations.init() || equations.get_problem(problem))
+    {
+        LOG(ERROR)<<"could not read the input file "<<input.string();
+        return 1;
+    }
+    return 0;
+}
+
+void solve(bear_sweep& sweep, const bear_problem& problem, sweep_point& point)
+{
+    auto start=std::chrono::steady_clock::now();
+    try
+    {
+        bear_result result=sweep.solve(problem);
+        point.rescaled=sweep.last_rescaled();
+        point.status=result.status();
+        point.levels=problem.charge_states.size();
+        if(!problem.charge_states.empty())
+        {
+            point.charge_min=problem.charge_states.front();
+            point.charge_max=problem.charge_states.back();
+        }
+        if(result.status())
+            LOG(ERROR)<<point.input.string()<<" (x"<<point.scale_factor<<") : "<<result.error();
+        else
+        {
+            point.mean_charge=result.mean_charge();
+            point.equilibrium.assign(result.equilibrium().begin(),result.equilibrium().end());
+            if(result.dynamic())
+                point.max_fraction_charge=result.charge_states()[result.max_fraction_index()];
+        }
+    }
+    catch(std::exception& e)
+    {
+        LOG(ERROR)<<point.input.string()<<" : "<<e.what();
+        point.status=1;
+    }
+    point.seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+}
+
+// one row per point, in the order of the sweep. The equilibrium fractions of the levels are
+// separated by spaces
+int write_summary(const std::string& filename, const std::vector<sweep_point>& points)
+{
+    std::ofstream file(filename.c_str(),std::ios::out|std::ios::trunc);
+    file<<"input,scale_factor,solve,status,levels,charge_min,charge_max,mean_charge,max_fraction_charge,seconds,equilibrium\n";
+    for(const auto& p : points)
+    {
+        std::string equilibrium;
+        for(std::size_t i(0); i<p.equilibrium.size(); i++)
+            equilibrium+=(i ? " " : "")+csv_number(p.equilibrium[i]);
+        file<<csv_quoted(p.input.string())<<","
+            <<csv_number(p.scale_factor)<<","
+            <<(p.rescaled ? "rescaled" : "full")<<","
+            <<(p.status ? "error" : "ok")<<","
+            <<p.levels<<","
+            <<p.charge_min<<","
+            <<p.charge_max<<","
+            <<csv_number(p.mean_charge)<<","
+            <<p.max_fraction_charge<<","
+            <<csv_number(p.seconds)<<","
+            <<csv_quoted(equilibrium)<<"\n";
+    }
+    return file ? 0 : 1;
+}
+
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        init_log_console(bear::severity_level::INFO,log_op::operation::GREATER_EQ_THAN);
+        LOG(STATE)<<"start BEAR sweep : Ballance Equations for Atomic Reactions";
+
+        /// /////////////////////////////////////////////////////
+        // PARSE OPTIONS : sweep options, then the bear options shared by all the input files
+        po::options_description sweep_desc("sweep options");
+        sweep_desc.add_options()
+            ("inputs",          po::value<std::vector<std::string> >()->multitoken(),               "input files, or directories (all their .txt files), in the order of the sweep")
+            ("scale-factors",   po::value<std::vector<double> >()->multitoken(),                    "factors of the cross-sections of each input file (e.g. target densities), default : 1")
+            ("summary",         po::value<std::string>()->default_value("bear-sweep-summary.csv"),  "summary file (csv, in the output directory)")
+        ;
+        po::variables_map sweep_vm;
+        po::store(po::command_line_parser(argc,argv).options(sweep_desc).allow_unregistered().run(),sweep_vm);
+        po::notify(sweep_vm);
+
+        equations_d options;
+        options.init_summary(std::make_shared<bear_summary>());
+        options.use_cfgFile();
+        options.set_input_required(false);
+        // one line per point in the summary : only warnings and errors by default
+        options.set_default_verbosity("WARN");
+        if(options.parse(argc, argv,true))
+        {
+            std::cout<<sweep_desc<<std::endl;
+            return 1;
+        }
+        const po::variables_map& vm=options.get_varMap();
+
+        std::vector<fs::path> inputs;
+        if(sweep_vm.count("inputs") && collect_inputs(sweep_vm["inputs"].as<std::vector<std::string> >(),inputs))
+            return 1;
+        if(inputs.empty())
+        {
+            LOG(ERROR)<<"no input file (--inputs file_or_directory ...)";
+            return 1;
+        }
+        std::vector<double> scale_factors(1,1.);
+        if(sweep_vm.count("scale-factors"))
+            scale_factors=sweep_vm["scale-factors"].as<std::vector<double> >();
+        for(double factor : scale_factors)
+            if(!(factor>0.))
+            {
+                LOG(ERROR)<<"the scale factors must be positive";
+                return 1;
+            }
+
+        /// /////////////////////////////////////////////////////
+        // SOLVE : the points in order, each input file with each scale factor. The input files
+        // that differ from a previous one by the target or the units only, and all the scale
+        // factors of an input file after the first one, are rescalings
+        std::vector<sweep_point> points;
+        bear_sweep sweep;
+        LOG(STATE)<<"solving "<<inputs.size()*scale_factors.size()<<" points ...";
+        auto start=std::chrono::steady_clock::now();
+        for(const auto& input : inputs)
+        {
+            bear_problem problem;
+            int status=read_problem(vm,input,problem);
+            const bear_problem::matrix_d cross_sections=problem.cross_sections;
+            for(double factor : scale_factors)
+            {
+                sweep_point point;
+                point.input=input;
+                point.scale_factor=factor;
+                if(status==0)
+                {
+                    problem.cross_sections=cross_sections*factor;
+                    solve(sweep,problem,point);
+                }
+                points.push_back(point);
+            }
+        }
+        double seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+
+        /// /////////////////////////////////////////////////////
+        // SUMMARY
+        std::size_t failed=std::count_if(points.begin(),points.end(),[](const sweep_point& p){ return p.status!=0; });
+        std::string summary=vm["output-directory"].as<fs::path>().string()+"/"+sweep_vm["summary"].as<std::string>();
+        if(write_summary(summary,points))
+        {
+            LOG(ERROR)<<"could not write the summary "<<summary;
+            return 1;
+        }
+        LOG(STATE)<<"solved "<<points.size()-failed<<"/"<<points.size()<<" points in "<<seconds<<" s ("
+                  <<sweep.full_solves()<<" decompositions, "<<sweep.rescaled_solves()<<" rescaled)";
+        LOG(STATE)<<"- summary : "<<summary;
+        if(failed)
+            return 1;
+    }
+    catch(std::exception& e)
+    {
+        LOG(ERROR) << e.what();
+        return 1;
+    }
+
+    LOG(INFO)<<"Execution successful!";
+    return 0;
+}
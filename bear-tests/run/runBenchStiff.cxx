@@ -0,0 +1,168 @@
+/*
+ * File:   runBenchStiff.cxx
+ *
+ * Created on October 17, 2026
+ */
+
+// steps of the Rosenbrock (RODAS3) and Dormand-Prince integrators as the stiffness of the system
+// grows : bench-stiff [--levels N] [--decades s ...] [--explicit-max-decades s] [--relative-tolerance r]
+//
+// The system is a ladder of N charge states, with one- and two-electron loss and one-electron
+// capture, whose rates decrease with the charge over s decades : the stiffness ratio is about 10^s.
+// The thickness range covers the relaxation of the slowest mode, and the tables are compared with
+// the eigen-solution of the core
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+
+#include "bear_core.h"
+#include "rosenbrock.h"
+#include "dormand_prince.h"
+#include "logger.h"
+
+#include "def.h"
+
+using namespace bear;
+
+typedef bear_problem::vector_d vector_d;
+typedef bear_problem::matrix_d matrix_d;
+
+// ladder of levels charge states, rates from 1 (q=0) down to 10^-decades (q=N-2)
+bear_problem stiff_problem(std::size_t levels, double decades, std::size_t point_number)
+{
+    bear_problem problem;
+    problem.charge_states.resize(levels);
+    problem.cross_sections=ublas::zero_matrix<double>(levels,levels);
+    for(std::size_t q(0); q<levels; q++)
+        problem.charge_states[q]=static_cast<int>(q);
+    for(std::size_t q(0); q+1<levels; q++)
+    {
+        double rate=std::pow(10.,-decades*double(q)/double(levels-2));
+        problem.cross_sections(q,q+1)=rate;
+        problem.cross_sections(q+1,q)=0.3*rate;
+        if(q+2<levels)
+            problem.cross_sections(q,q+2)=0.05*rate;
+    }
+    problem.initial_condition=ublas::zero_vector<double>(levels);
+    problem.initial_condition(0)=1.;
+    problem.thickness_minimum=0.;
+    problem.thickness_maximum=20.*std::pow(10.,decades);
+    problem.thickness_point_number=point_number;
+    problem.sampling="log";
+    return problem;
+}
+
+double max_difference(const thickness_table<double>& table, const thickness_table<double>& reference)
+{
+    double diff=0.;
+    for(std::size_t k(0); k<reference.points(); k++)
+        for(std::size_t i(0); i<reference.levels(); i++)
+            diff=std::max(diff,std::abs(table.column(k)[i]-reference.column(k)[i]));
+    return diff;
+}
+
+template<typename integrator>
+int run(integrator& solver, const bear_result& result, double rtol, double atol, thickness_table<double>& table,
+        double& seconds)
+{
+    auto start=std::chrono::steady_clock::now();
+    if(solver.init(result.system_matrix(),result.second_member()))
+        return 1;
+    solver.set_tolerances(rtol,atol);
+    int status=solver.integrate(result.initial_condition(),table);
+    seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return status;
+}
+
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        init_log_console(bear::severity_level::RESULTS,log_op::operation::GREATER_EQ_THAN);
+
+        po::options_description desc("bench-stiff options");
+        desc.add_options()
+            ("help",                    "print this message")
+            ("levels",                  po::value<std::size_t>()->default_value(15),            "number of charge states")
+            ("decades",                 po::value<std::vector<double> >()->multitoken(),        "spreads of the rates (decades), default : 0 2 4 6 8 10")
+            ("explicit-max-decades",    po::value<double>()->default_value(5.),                 "Dormand-Prince only up to this spread (its steps grow as 10^s)")
+            ("relative-tolerance",      po::value<double>()->default_value(1.e-8),              "relative tolerance of the integrators")
+            ("absolute-tolerance",      po::value<double>()->default_value(1.e-12),             "absolute tolerance of the integrators")
+            ("point-number",            po::value<std::size_t>()->default_value(200),           "number of points of the (log) thickness grid")
+        ;
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc,argv,desc),vm);
+        po::notify(vm);
+        if(vm.count("help"))
+        {
+            std::cout<<desc<<std::endl;
+            return 0;
+        }
+
+        const std::size_t levels=vm["levels"].as<std::size_t>();
+        const double rtol=vm["relative-tolerance"].as<double>();
+        const double atol=vm["absolute-tolerance"].as<double>();
+        const double explicit_max=vm["explicit-max-decades"].as<double>();
+        std::vector<double> decades={0.,2.,4.,6.,8.,10.};
+        if(vm.count("decades"))
+            decades=vm["decades"].as<std::vector<double> >();
+        if(levels<3)
+        {
+            LOG(ERROR)<<"the ladder needs at least 3 charge states";
+            return 1;
+        }
+
+        LOG(RESULTS)<<"levels = "<<levels<<", rtol = "<<rtol<<", atol = "<<atol;
+        LOG(RESULTS)<<"decades | rosenbrock : accepted rejected factorizations max|dF| seconds"
+                    <<" | dormand-prince : accepted rejected max|dF| seconds";
+        for(double spread : decades)
+        {
+            bear_problem problem=stiff_problem(levels,spread,vm["point-number"].as<std::size_t>());
+            bear_result result=bear_solve(problem);
+            thickness_table<double> reference;
+            if(result.status() || result.tabulate(reference))
+            {
+                LOG(ERROR)<<"eigen-solution failed for "<<spread<<" decades : "<<result.error();
+                return 1;
+            }
+
+            std::ostringstream line;
+            line<<spread<<" | ";
+
+            rosenbrock<double> stiff;
+            thickness_table<double> table=reference;
+            double seconds=0.;
+            if(run(stiff,result,rtol,atol,table,seconds))
+                line<<"failed";
+            else
+                line<<stiff.accepted_steps()<<" "<<stiff.rejected_steps()<<" "<<stiff.factorizations()<<" "
+                    <<max_difference(table,reference)<<" "<<seconds;
+
+            line<<" | ";
+            if(spread<=explicit_max)
+            {
+                dormand_prince<double> explicit_solver;
+                table=reference;
+                if(run(explicit_solver,result,rtol,atol,table,seconds))
+                    line<<"failed";
+                else
+                    line<<explicit_solver.accepted_steps()<<" "<<explicit_solver.rejected_steps()<<" "
+                        <<max_difference(table,reference)<<" "<<seconds;
+            }
+            else
+                line<<"skipped";
+            LOG(RESULTS)<<line.str();
+        }
+    }
+    catch(std::exception& e)
+    {
+        LOG(ERROR) << e.what();
+        return 1;
+    }
+    return 0;
+}
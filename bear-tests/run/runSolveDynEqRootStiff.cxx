@@ -0,0 +1,104 @@
+/* 
+ * File:   runSolveDynEqRootStiff.cxx
+ *
+ * Created on October 17, 2026
+ */
+
+#include "equations_manager.h"
+#include "bear_equations.h"
+#include "solve_bear_equations_rosenbrock.h"
+#include "bear_user_interface.h"
+#include "bear_gui_root.h"
+#include "logger.h"
+#include "TApplication.h"
+
+#include "def.h"
+
+using namespace bear;
+
+typedef bear_equations<double> equations_d;
+typedef solve_bear_equations_rosenbrock<double> solve_method_d;
+typedef equations_manager<double,equations_d,solve_method_d,bear_gui_root> bear_manager;
+
+
+int main(int argc, char** argv) 
+{
+    try
+    {
+        init_log_console(bear::severity_level::INFO,log_op::operation::GREATER_EQ_THAN);
+        /// /////////////////////////////////////////////////////
+        // CREATE EQUATION MANAGER
+        LOG(STATE)<<"start BEAR : Ballance Equations for Atomic Reactions";
+        bear_manager man;
+        man.use_cfgFile();
+        
+        /// /////////////////////////////////////////////////////
+        // PARSE OPTIONS
+        LOG(INFO)<<" ";
+        LOG(STATE)<<"parsing command line and input files ...";
+        LOG(INFO)<<" ";
+        if(man.parse(argc, argv,true))
+            return 1;
+        
+        bool plot = man.get_varMap()["plot"].as<bool>();
+        bool save = man.get_varMap()["save"].as<bool>();
+        bool save_fig = man.get_varMap()["save-fig-ne"].as<bool>();
+        /// /////////////////////////////////////////////////////
+        // INIT EQUATIONS
+        LOG(INFO)<<" ";
+        LOG(STATE)<<"initializing ...";
+        if(man.init())
+            return 1;
+        
+        /// /////////////////////////////////////////////////////
+        // RUN SOLVE EQUATIONS
+        LOG(INFO)<<" ";
+        LOG(STATE)<<"running ...";
+        if(man.run())
+            return 1;
+        
+        
+        
+        /// /////////////////////////////////////////////////////
+        // SAVE
+        if(save)
+        {
+            LOG(INFO)<<" ";
+            LOG(STATE)<<"saving to file ...";
+            if(man.save()) 
+                return 1;
+        }
+            
+        /// /////////////////////////////////////////////////////
+        // PLOT
+        
+        if(plot)
+        {
+            TApplication app("App", nullptr, 0);
+            LOG(INFO)<<" ";
+            LOG(STATE)<<"plotting ...";
+            if(man.plot()) 
+                return 1;
+            // run event loop
+            app.Run();
+        }
+        else
+        {
+            if(save_fig)
+            {
+                
+                if(man.plot()) 
+                    return 1;
+            }
+        }
+        
+    }
+    catch(std::exception& e)
+    {
+        LOG(ERROR) << e.what();
+        return 1;
+    }
+    
+    LOG(INFO)<<"Execution successful!";
+    return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ * File:   test_solve_methods.cxx
+ *
+ * Created on October 17, 2026
+ */
+
+// one input file, then a cycle of 3 charge states (complex conjugate eigenvalues, paired by the
+// core), solved with every method, the tables compared with the one of the eigen decomposition :
+// runMethodsTest -c config_file --input-file file [--tolerance t] [--integrator-tolerance t]
+//
+// - propagator : matrix exponential exp(A dx) (bear_problem::propagator)
+// - reprojection : constants of a new F(x=0) from the left eigenvectors (bear_reproject)
+// - scan : the same F(x=0) as the single column of a parameter scan (left projection matrix)
+// - Dormand-Prince, Rosenbrock and uniformization : integration of dF/dx = AF + g (or MF)
+//
+// The adaptive sampling only exists for the eigen decomposition : the log grid is used instead.
+// Returns 1 if a method fails or if its table differs from the reference by more than the tolerance
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "bear_equations.h"
+#include "bear_core.h"
+#include "bear_system.h"
+#include "dormand_prince.h"
+#include "rosenbrock.h"
+#include "uniformization.h"
+#include "logger.h"
+
+#include "def.h"
+
+using namespace bear;
+
+typedef bear_equations<double>      equations_d;
+typedef bear_problem::vector_d      vector_d;
+typedef bear_problem::matrix_d      matrix_d;
+
+// max |F_i(x_k) - F_ref_i(x_k)| over the grid, infinite if the grids differ
+double max_difference(const thickness_table<double>& table, const thickness_table<double>& reference)
+{
+    if(table.points()!=reference.points() || table.levels()!=reference.levels())
+        return INFINITY;
+    double diff=0.;
+    for(std::size_t k(0); k<reference.points(); k++)
+    {
+        if(table.x(k)!=reference.x(k))
+            return INFINITY;
+        for(std::size_t i(0); i<reference.levels(); i++)
+            diff=std::max(diff,std::abs(table.column(k)[i]-reference.column(k)[i]));
+    }
+    return diff;
+}
+
+// logs the difference of the method, returns 1 if the method failed or is out of tolerance
+int check(const std::string& method, int status, const thickness_table<double>& table,
+          const thickness_table<double>& reference, double tolerance)
+{
+    if(status)
+    {
+        LOG(ERROR)<<method<<" : failed";
+        return 1;
+    }
+    double diff=max_difference(table,reference);
+    if(!(diff<=tolerance))
+    {
+        LOG(ERROR)<<method<<" : max|dF| = "<<diff<<" > "<<tolerance;
+        return 1;
+    }
+    LOG(RESULTS)<<method<<" : max|dF| = "<<diff<<" (tolerance "<<tolerance<<")";
+    return 0;
+}
+
+// cycle of 3 charge states 0 -> 1 -> 2 -> 0 : two complex conjugate eigenvalues
+bear_problem cyclic_problem()
+{
+    bear_problem problem;
+    problem.charge_states={0,1,2};
+    problem.cross_sections=ublas::zero_matrix<double>(3,3);
+    problem.cross_sections(0,1)=1.;
+    problem.cross_sections(1,2)=1.;
+    problem.cross_sections(2,0)=1.;
+    problem.initial_condition=ublas::zero_vector<double>(3);
+    problem.initial_condition(0)=1.;
+    problem.thickness_minimum=0.;
+    problem.thickness_maximum=10.;
+    problem.thickness_point_number=200;
+    problem.sampling="linear";
+    return problem;
+}
+
+// tables of every method compared with the one of the eigen decomposition, returns the number
+// of methods that failed or are out of tolerance
+int compare_methods(const std::string& name, bear_problem problem, double tolerance, double integrator_tolerance)
+{
+    LOG(RESULTS)<<"*** "<<name;
+    problem.propagator=false;
+    if(problem.sampling=="adaptive")
+        problem.sampling="log";
+
+    /// /////////////////////////////////////////////////////
+    // REFERENCE : eigen decomposition
+    bear_result result=bear_solve(problem);
+    thickness_table<double> reference;
+    if(result.status() || result.tabulate(reference))
+    {
+        LOG(ERROR)<<"eigen decomposition : "<<result.error();
+        return 1;
+    }
+    if(!result.diagonalized())
+    {
+        LOG(ERROR)<<"eigen decomposition : the system matrix is not diagonalizable";
+        return 1;
+    }
+    LOG(RESULTS)<<"eigen decomposition : "<<reference.points()<<" points, "<<reference.levels()<<" levels";
+
+    int failures=0;
+
+    /// /////////////////////////////////////////////////////
+    // EXACT METHODS
+    {
+        bear_problem propagator_problem=problem;
+        propagator_problem.propagator=true;
+        bear_result propagator_result=bear_solve(propagator_problem);
+        thickness_table<double> table;
+        int status=propagator_result.status() || propagator_result.tabulate(table);
+        failures+=check("propagator",status,table,reference,tolerance);
+    }
+
+    {
+        bear_result reprojected=bear_reproject(result,problem);
+        thickness_table<double> table;
+        int status=reprojected.status() || reprojected.tabulate(table);
+        failures+=check("reprojection",status,table,reference,tolerance);
+    }
+
+    {
+        bear_problem scan_problem=problem;
+        scan_problem.initial_conditions.resize(problem.initial_condition.size(),1,false);
+        ublas::column(scan_problem.initial_conditions,0)=problem.initial_condition;
+        bear_result scan_result=bear_solve(scan_problem);
+        std::vector<thickness_table<double> > tables;
+        int status=scan_result.status() || scan_result.tabulate_scan(tables) || tables.size()!=1;
+        failures+=check("scan",status,status ? reference : tables[0],reference,tolerance);
+    }
+
+    /// /////////////////////////////////////////////////////
+    // INTEGRATORS : on the grid of the reference
+    {
+        dormand_prince<double> solver;
+        thickness_table<double> table=reference;
+        int status=solver.init(result.system_matrix(),result.second_member());
+        if(!status)
+        {
+            solver.set_tolerances(1.e-3*integrator_tolerance,1.e-3*integrator_tolerance);
+            status=solver.integrate(result.initial_condition(),table);
+        }
+        failures+=check("Dormand-Prince",status,table,reference,integrator_tolerance);
+    }
+
+    {
+        rosenbrock<double> solver;
+        thickness_table<double> table=reference;
+        int status=solver.init(result.system_matrix(),result.second_member());
+        if(!status)
+        {
+            solver.set_tolerances(1.e-3*integrator_tolerance,1.e-3*integrator_tolerance);
+            status=solver.integrate(result.initial_condition(),table);
+        }
+        failures+=check("Rosenbrock",status,table,reference,integrator_tolerance);
+    }
+
+    {
+        matrix_d M;
+        expand_system(result.system_matrix(),result.second_member(),M);
+        uniformization<double> solver;
+        thickness_table<double> table=reference;
+        int status=solver.init(M);
+        if(!status)
+        {
+            solver.set_tolerance(1.e-3*integrator_tolerance);
+            status=solver.integrate(result.initial_condition(),table);
+        }
+        failures+=check("uniformization",status,table,reference,integrator_tolerance);
+    }
+    return failures;
+}
+
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        init_log_console(bear::severity_level::RESULTS,log_op::operation::GREATER_EQ_THAN);
+
+        po::options_description test_desc("test options");
+        test_desc.add_options()
+            ("tolerance",               po::value<double>()->default_value(1.e-10),     "max. difference of the propagator and of the left projections")
+            ("integrator-tolerance",    po::value<double>()->default_value(1.e-7),      "max. difference of the integrators (Dormand-Prince, Rosenbrock, uniformization)")
+        ;
+        po::variables_map test_vm;
+        po::store(po::command_line_parser(argc,argv).options(test_desc).allow_unregistered().run(),test_vm);
+        po::notify(test_vm);
+        const double tolerance=test_vm["tolerance"].as<double>();
+        const double integrator_tolerance=test_vm["integrator-tolerance"].as<double>();
+
+        equations_d equations;
+        equations.init_summary(std::make_shared<bear_summary>());
+        equations.use_cfgFile();
+        equations.set_default_verbosity("RESULTS");
+        bear_problem problem;
+        if(equations.parse(argc,argv,true) || equations.init() || equations.get_problem(problem))
+        {
+            std::cout<<test_desc<<std::endl;
+            return 1;
+        }
+        if(problem.initial_condition.empty())
+        {
+            LOG(ERROR)<<"the input file has no initial conditions";
+            return 1;
+        }
+        int failures=compare_methods(equations.get_varMap()["input-file"].as<fs::path>().string(),problem,
+                                     tolerance,integrator_tolerance);
+        failures+=compare_methods("cyclic system (complex eigenvalues)",cyclic_problem(),tolerance,integrator_tolerance);
+
+        if(failures)
+        {
+            LOG(ERROR)<<failures<<" method(s) out of tolerance";
+            return 1;
+        }
+    }
+    catch(std::exception& e)
+    {
+        LOG(ERROR) << e.what();
+        return 1;
+    }
+
+    LOG(RESULTS)<<"all methods agree with the eigen decomposition";
+    return 0;
+}
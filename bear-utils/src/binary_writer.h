@@ -0,0 +1,214 @@
+/*
+ * File:   binary_writer.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BINARY_WRITER_H
+#define	BINARY_WRITER_H
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "table_writer.h"
+#include "io_utils.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Binary results : each array is written to its own file as contiguous float64 //
+    /// (C order), either as a NPY file (version 1.0, loadable with numpy.load) or  //
+    /// as raw little-endian data (numpy.fromfile, shape from the header). A small  //
+    /// JSON file (prefix.json) describes the arrays (file, dtype, shape) and holds //
+    /// the metadata of the run.                                                    //
+    /// //////////////////////////////////////////////////////////////////////////////
+    class binary_writer
+    {
+    public:
+        enum format {kNpy,kRaw};
+
+        // files are named prefix-<array name>.npy (or .bin) and prefix.json
+        binary_writer(const std::string& prefix, format fmt=kNpy) :
+                                fPrefix(prefix), fFormat(fmt), fMetadata(), fArrays()
+        {}
+        virtual ~binary_writer(){}
+
+        // "npy" or "raw", return 1 if unknown
+        static int parse_format(const std::string& name, format& fmt)
+        {
+            if(name=="npy")
+                fmt=kNpy;
+            else if(name=="raw")
+                fmt=kRaw;
+            else
+                return 1;
+            return 0;
+        }
+
+        // float64 array of the given shape (C order : the last index is contiguous)
+        int write_array(const std::string& name, const double* data, const std::vector<std::size_t>& shape)
+        {
+            std::size_t count=1;
+            for(std::size_t n : shape)
+                count*=n;
+
+            std::string filename=fPrefix+"-"+name+(fFormat==kNpy ? ".npy" : ".bin");
+            std::ofstream file(filename.c_str(),std::ios::out|std::ios::binary|std::ios::trunc);
+            if(!file)
+                return 1;
+            if(fFormat==kNpy)
+            {
+                std::string header=npy_header(shape);
+                file.write(header.data(),header.size());
+            }
+            write_little_endian(file,data,count);
+            if(!file)
+                return 1;
+
+            std::ostringstream os;
+            os<<"{\"file\": "<<json_string(base_name(filename))
+              <<", \"dtype\": \"<f8\", \"order\": \"C\", \"shape\": [";
+            for(std::size_t i(0); i<shape.size(); i++)
+                os<<(i>0 ? ", " : "")<<shape[i];
+            os<<"]}";
+            fArrays.push_back(std::make_pair(name,os.str()));
+            return 0;
+        }
+
+        void add_metadata(const std::string& key, const std::string& value)
+        {
+            fMetadata.push_back(std::make_pair(key,json_string(value)));
+        }
+
+        void add_metadata(const std::string& key, double value)
+        {
+            fMetadata.push_back(std::make_pair(key,json_number(value)));
+        }
+
+        void add_metadata(const std::string& key, std::size_t value)
+        {
+            fMetadata.push_back(std::make_pair(key,std::to_string(value)));
+        }
+
+        template<typename T>
+        void add_metadata(const std::string& key, const std::vector<T>& values)
+        {
+            std::string json="[";
+            for(std::size_t i(0); i<values.size(); i++)
+            {
+                if(i>0)
+                    json+=", ";
+                json+=json_number(static_cast<double>(values[i]));
+            }
+            json+="]";
+            fMetadata.push_back(std::make_pair(key,json));
+        }
+
+        // e.g. charge states, as json integers
+        void add_metadata(const std::string& key, const std::vector<int>& values)
+        {
+            std::string json="[";
+            for(std::size_t i(0); i<values.size(); i++)
+                json+=(i>0 ? ", " : "")+std::to_string(values[i]);
+            json+="]";
+            fMetadata.push_back(std::make_pair(key,json));
+        }
+
+        // already formatted JSON value (object, array)
+        void add_metadata_json(const std::string& key, const std::string& json)
+        {
+            fMetadata.push_back(std::make_pair(key,json));
+        }
+
+        // prefix.json : metadata and description of the arrays written so far
+        int write_header() const
+        {
+            std::string filename=fPrefix+".json";
+            std::ofstream file(filename.c_str(),std::ios::out|std::ios::trunc);
+            if(!file)
+                return 1;
+            file<<"{\n";
+            file<<"  \"format\": "<<json_string(fFormat==kNpy ? "npy" : "raw");
+            for(const auto& p : fMetadata)
+                file<<",\n  "<<json_string(p.first)<<": "<<p.second;
+            file<<",\n  \"arrays\": {";
+            for(std::size_t i(0); i<fArrays.size(); i++)
+                file<<(i>0 ? "," : "")<<"\n    "<<json_string(fArrays[i].first)<<": "<<fArrays[i].second;
+            file<<"\n  }\n}\n";
+            return file ? 0 : 1;
+        }
+
+        std::string header_filename() const { return fPrefix+".json"; }
+
+    private:
+        // magic string, version 1.0, header length (uint16 LE), then the python dict
+        // padded with spaces so that the data starts on a 64 byte boundary
+        static std::string npy_header(const std::vector<std::size_t>& shape)
+        {
+            std::string dict="{'descr': '<f8', 'fortran_order': False, 'shape': (";
+            for(std::size_t i(0); i<shape.size(); i++)
+                dict+=(i>0 ? ", " : "")+std::to_string(shape[i]);
+            if(shape.size()==1)
+                dict+=",";
+            dict+="), }";
+
+            const std::size_t preamble=10;
+            std::size_t length=dict.size()+1;
+            length+=(64-(preamble+length)%64)%64;
+            dict.append(length-dict.size()-1,' ');
+            dict+='\n';
+
+            std::string header("\x93NUMPY\x01\x00",8);
+            header+=static_cast<char>(length & 0xff);
+            header+=static_cast<char>((length>>8) & 0xff);
+            return header+dict;
+        }
+
+        static void write_little_endian(std::ofstream& file, const double* data, std::size_t count)
+        {
+            const std::uint16_t one=1;
+            unsigned char first_byte;
+            std::memcpy(&first_byte,&one,1);
+            if(first_byte==1)
+            {
+                file.write(reinterpret_cast<const char*>(data),count*sizeof(double));
+                return;
+            }
+
+            // big endian host : swap the bytes by blocks
+            const std::size_t block_size=4096;
+            std::vector<char> buffer(block_size*sizeof(double));
+            for(std::size_t k0(0); k0<count; k0+=block_size)
+            {
+                std::size_t n=std::min(block_size,count-k0);
+                std::memcpy(&buffer[0],data+k0,n*sizeof(double));
+                for(std::size_t k(0); k<n; k++)
+                    std::reverse(&buffer[k*sizeof(double)],&buffer[(k+1)*sizeof(double)]);
+                file.write(&buffer[0],n*sizeof(double));
+            }
+        }
+
+        static std::string base_name(const std::string& path)
+        {
+            std::size_t pos=path.find_last_of('/');
+            return pos==std::string::npos ? path : path.substr(pos+1);
+        }
+
+        std::string fPrefix;
+        format fFormat;
+        std::vector<std::pair<std::string,std::string> > fMetadata;    // key -> JSON value
+        std::vector<std::pair<std::string,std::string> > fArrays;      // name -> JSON description
+    };
+}
+
+#endif	/* BINARY_WRITER_H */
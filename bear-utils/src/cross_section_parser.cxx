@@ -0,0 +1,356 @@
+/*
+ * File:   cross_section_parser.cxx
+ *
+ * Created on October 17, 2026
+ */
+
+#include "cross_section_parser.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+
+#include "logger.h"
+
+namespace bear
+{
+    /// //////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// cross_section_table
+
+    void cross_section_table::reset(std::size_t index_min, std::size_t index_max)
+    {
+        fIndex_min=index_min;
+        fDim= index_max>=index_min ? index_max-index_min+1 : 0;
+        fValues.assign(fDim*fDim,0.);
+        fDefined.assign(fDim*fDim,0);
+    }
+
+    void cross_section_table::clear()
+    {
+        fIndex_min=0;
+        fDim=0;
+        fValues.clear();
+        fDefined.clear();
+    }
+
+    void cross_section_table::scale(double factor)
+    {
+        for(auto& val : fValues)
+            val*=factor;
+    }
+
+
+
+    /// //////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// helper functions
+    namespace
+    {
+        inline bool is_blank(char c)
+        {
+            return c==' ' || c=='\t' || c=='\r' || c=='\v' || c=='\f';
+        }
+
+        // trim [first,last) in place
+        inline void trim(const char*& first, const char*& last)
+        {
+            while(first<last && is_blank(*first))
+                ++first;
+            while(last>first && is_blank(*(last-1)))
+                --last;
+        }
+
+        inline bool starts_with(const std::string& str, const std::string& prefix)
+        {
+            return str.size()>=prefix.size() && str.compare(0,prefix.size(),prefix)==0;
+        }
+
+        // parse unsigned integer at position pos, advance pos. Once the index exceeds index_max,
+        // too_large is set and the remaining digits are skipped : the index never wraps around
+        inline bool read_index(const std::string& str, std::size_t& pos, std::size_t index_max,
+                               std::size_t& index, bool& too_large)
+        {
+            std::size_t start=pos;
+            index=0;
+            while(pos<str.size() && str[pos]>='0' && str[pos]<='9')
+            {
+                std::size_t d=static_cast<std::size_t>(str[pos]-'0');
+                if(too_large || index>index_max/10 || d>index_max-10*index)
+                    too_large=true;
+                else
+                    index=10*index+d;
+                ++pos;
+            }
+            return pos>start;
+        }
+
+        inline bool read_double(const std::string& str, double& val)
+        {
+            if(str.empty())
+                return false;
+            const char* begin=str.c_str();
+            char* end=nullptr;
+            errno=0;
+            val=std::strtod(begin,&end);
+            return end==begin+str.size() && errno!=ERANGE;
+        }
+    }
+
+
+
+    /// //////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// cross_section_parser
+
+    cross_section_parser::cross_section_parser() :  fCoef_prefix(),
+                                                    fCoef_sep(),
+                                                    fInit_cond_prefix(),
+                                                    fInit_cond_suffix(),
+                                                    fRange_min(0),
+                                                    fRange_max(std::numeric_limits<std::size_t>::max()),
+                                                    fHeader(),
+                                                    fEntries(),
+                                                    fCoefficients(),
+                                                    fInitial_conditions(),
+                                                    fIndex_i_min(0), fIndex_i_max(0),
+                                                    fIndex_j_min(0), fIndex_j_max(0)
+    {
+        set_format();
+    }
+
+
+    void cross_section_parser::set_format(const std::string& symbol, const std::string& sep1, const std::string& sep2, const std::string& sep3, const std::string& section)
+    {
+        fCoef_prefix=section+"."+symbol+sep1;
+        fCoef_sep=sep2;
+        fInit_cond_prefix=section+".F0"+sep1;
+        fInit_cond_suffix=sep3;
+    }
+
+
+    void cross_section_parser::set_index_range(std::size_t index_min, std::size_t index_max)
+    {
+        fRange_min=index_min;
+        fRange_max=index_max;
+    }
+
+
+    int cross_section_parser::parse(const std::string& filename)
+    {
+        std::ifstream infile(filename.c_str(), std::ios::in | std::ios::binary);
+        if(!infile)
+        {
+            LOG(ERROR)<<"can not open file: '" << filename <<"'";
+            return 1;
+        }
+
+        // read the whole file at once
+        std::string content;
+        infile.seekg(0, std::ios::end);
+        std::streamoff length=infile.tellg();
+        if(length>0)
+        {
+            content.resize(static_cast<std::size_t>(length));
+            infile.seekg(0, std::ios::beg);
+            infile.read(&content[0], length);
+        }
+        infile.close();
+
+        return parse_string(content,filename);
+    }
+
+
+    int cross_section_parser::parse_string(const std::string& content, const std::string& source_name)
+    {
+        fHeader.clear();
+        fEntries.clear();
+        fCoefficients.clear();
+        fInitial_conditions.clear();
+
+        fIndex_i_min = std::numeric_limits<std::size_t>::max();
+        fIndex_i_max = std::numeric_limits<std::size_t>::min();
+        fIndex_j_min = std::numeric_limits<std::size_t>::max();
+        fIndex_j_max = std::numeric_limits<std::size_t>::min();
+
+        const char* pos=content.data();
+        const char* end=content.data()+content.size();
+
+        // handle UTF8 BOM case
+        if (content.compare( 0, 3, "\xEF\xBB\xBF" ) == 0)
+            pos+=3;
+
+        std::string section;
+        std::string key;
+        std::string value;
+        std::size_t line_number=0;
+
+        while(pos<end)
+        {
+            const char* line_end=std::find(pos,end,'\n');
+            const char* first=pos;
+            const char* last=std::find(first,line_end,'#');// remove comments
+            pos= line_end<end ? line_end+1 : end;
+            ++line_number;
+
+            trim(first,last);
+            if(first==last)
+                continue;
+
+            // section
+            if(*first=='[')
+            {
+                if(*(last-1)!=']')
+                {
+                    LOG(ERROR)<<source_name<<":"<<line_number<<" : invalid section '"<< std::string(first,last) <<"'";
+                    return 1;
+                }
+                ++first;
+                --last;
+                trim(first,last);
+                section.assign(first,last);
+                if(!section.empty())
+                    section+=".";
+                continue;
+            }
+
+            // key = value
+            const char* equal=std::find(first,last,'=');
+            if(equal==last)
+            {
+                LOG(ERROR)<<source_name<<":"<<line_number<<" : invalid line '"<< std::string(first,last) <<"' (expected key = value)";
+                return 1;
+            }
+
+            const char* key_first=first;
+            const char* key_last=equal;
+            const char* value_first=equal+1;
+            const char* value_last=last;
+            trim(key_first,key_last);
+            trim(value_first,value_last);
+
+            key=section;
+            key.append(key_first,key_last);
+            value.assign(value_first,value_last);
+
+            if(store(key,value,source_name,line_number))
+                return 1;
+        }
+
+        // fill the dense table over the found index range
+        if(!fEntries.empty())
+        {
+            fCoefficients.reset(std::min(fIndex_i_min,fIndex_j_min), std::max(fIndex_i_max,fIndex_j_max));
+            for(const auto& entry : fEntries)
+            {
+                std::size_t i=std::get<0>(entry);
+                std::size_t j=std::get<1>(entry);
+                if(fCoefficients.defined(i,j))
+                {
+                    LOG(ERROR)<<source_name<<" : multiple occurrences of cross-section coefficient "<<fCoef_prefix<<i<<fCoef_sep<<j;
+                    return 1;
+                }
+                fCoefficients.set(i,j,std::get<2>(entry));
+            }
+        }
+        fEntries.clear();
+
+        return 0;
+    }
+
+
+    int cross_section_parser::store(const std::string& key, const std::string& value, const std::string& source_name, std::size_t line_number)
+    {
+        std::size_t i=0;
+        std::size_t j=0;
+        double val=0.;
+        bool too_large=false;
+
+        if(match_coef_key(key,i,j,too_large))
+        {
+            if(!read_double(value,val))
+            {
+                LOG(ERROR)<<source_name<<":"<<line_number<<" : invalid value '"<< value <<"' for cross-section coefficient "<< key;
+                return 1;
+            }
+
+            if(too_large || i<fRange_min || i>fRange_max || j<fRange_min || j>fRange_max)
+            {
+                LOG(ERROR)<<source_name<<":"<<line_number<<" : cross-section coefficient "<< key
+                          <<" is out of the index range ["<<fRange_min<<","<<fRange_max<<"]";
+                return 1;
+            }
+
+            fEntries.push_back(std::make_tuple(i,j,val));
+
+            // to resize matrix properly :
+            // get the max/min indices of the coef.
+            if(i<fIndex_i_min)
+                fIndex_i_min=i;
+            if(i>fIndex_i_max)
+                fIndex_i_max=i;
+            if(j<fIndex_j_min)
+                fIndex_j_min=j;
+            if(j>fIndex_j_max)
+                fIndex_j_max=j;
+            return 0;
+        }
+
+        if(match_init_cond_key(key,i,too_large))
+        {
+            if(!read_double(value,val))
+            {
+                LOG(ERROR)<<source_name<<":"<<line_number<<" : invalid value '"<< value <<"' for initial condition "<< key;
+                return 1;
+            }
+
+            if(too_large || i<fRange_min || i>fRange_max)
+            {
+                LOG(ERROR)<<source_name<<":"<<line_number<<" : initial condition "<< key
+                          <<" is out of the index range ["<<fRange_min<<","<<fRange_max<<"]";
+                return 1;
+            }
+
+            if(!fInitial_conditions.insert(std::make_pair(i,val)).second)
+            {
+                LOG(ERROR)<<source_name<<":"<<line_number<<" : multiple occurrences of initial condition "<< key;
+                return 1;
+            }
+            return 0;
+        }
+
+        fHeader.push_back(key_value(key,value));
+        return 0;
+    }
+
+
+    bool cross_section_parser::match_coef_key(const std::string& key, std::size_t& i, std::size_t& j, bool& too_large) const
+    {
+        if(!starts_with(key,fCoef_prefix))
+            return false;
+
+        std::size_t pos=fCoef_prefix.size();
+        if(!read_index(key,pos,fRange_max,i,too_large))
+            return false;
+        if(key.compare(pos,fCoef_sep.size(),fCoef_sep)!=0)
+            return false;
+        pos+=fCoef_sep.size();
+        if(!read_index(key,pos,fRange_max,j,too_large))
+            return false;
+
+        return pos==key.size();
+    }
+
+
+    bool cross_section_parser::match_init_cond_key(const std::string& key, std::size_t& i, bool& too_large) const
+    {
+        if(!starts_with(key,fInit_cond_prefix))
+            return false;
+
+        std::size_t pos=fInit_cond_prefix.size();
+        if(!read_index(key,pos,fRange_max,i,too_large))
+            return false;
+
+        return pos+fInit_cond_suffix.size()==key.size() && key.compare(pos,fInit_cond_suffix.size(),fInit_cond_suffix)==0;
+    }
+}
+
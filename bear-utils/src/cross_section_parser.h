@@ -0,0 +1,151 @@
+/*
+ * File:   cross_section_parser.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef CROSS_SECTION_PARSER_H
+#define	CROSS_SECTION_PARSER_H
+
+// std
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <limits>
+#include <stdexcept>
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    // dense table of the cross-section coefficients Qij, stored contiguously
+    // (row-major, Q(i,j) at (i-min)*dim+(j-min)) and addressed with the real
+    // charge state indices i,j in [index_min(), index_max()]
+    class cross_section_table
+    {
+    public:
+        cross_section_table() : fIndex_min(0), fDim(0), fValues(), fDefined() {}
+        virtual ~cross_section_table(){}
+
+        void reset(std::size_t index_min, std::size_t index_max);
+        void clear();
+
+        double& operator()(std::size_t i, std::size_t j)
+        {
+            return fValues[(i-fIndex_min)*fDim+(j-fIndex_min)];
+        }
+
+        double operator()(std::size_t i, std::size_t j) const
+        {
+            return fValues[(i-fIndex_min)*fDim+(j-fIndex_min)];
+        }
+
+        // bound checked access (same semantic as std::map::at)
+        double at(std::size_t i, std::size_t j) const
+        {
+            if(!contains(i,j))
+                throw std::out_of_range("cross-section coefficient index out of range");
+            return (*this)(i,j);
+        }
+
+        bool contains(std::size_t i, std::size_t j) const
+        {
+            return fDim>0 && i>=fIndex_min && j>=fIndex_min && i<fIndex_min+fDim && j<fIndex_min+fDim;
+        }
+
+        // true if the coefficient was explicitly given in the input file
+        bool defined(std::size_t i, std::size_t j) const
+        {
+            return contains(i,j) && fDefined[(i-fIndex_min)*fDim+(j-fIndex_min)];
+        }
+
+        void set(std::size_t i, std::size_t j, double val)
+        {
+            fValues[(i-fIndex_min)*fDim+(j-fIndex_min)]=val;
+            fDefined[(i-fIndex_min)*fDim+(j-fIndex_min)]=1;
+        }
+
+        void scale(double factor);
+
+        std::size_t index_min() const { return fIndex_min; }
+        std::size_t index_max() const { return fIndex_min+fDim-1; }
+        std::size_t dim() const { return fDim; }
+        bool empty() const { return fDim==0; }
+        const double* data() const { return fValues.data(); }
+
+    private:
+        std::size_t fIndex_min;
+        std::size_t fDim;
+        std::vector<double> fValues;
+        std::vector<char> fDefined;
+    };
+
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    // single pass parser of the INI-like input file.
+    // Reads the whole file once (UTF-8 BOM is skipped), and sorts each key=value
+    // into : cross-sections "Q.i.j" and initial conditions "F0.i" of the
+    // [cross.section] section, or header entries (everything else, e.g.
+    // "projectile.symbol") left to the caller for typed conversion.
+    class cross_section_parser
+    {
+    public:
+        typedef std::pair<std::string, std::string>                    key_value;
+
+        cross_section_parser();
+        virtual ~cross_section_parser(){}
+
+        // key format : <section>.<symbol><sep1>i<sep2>j and <section>.F0<sep1>i<sep3>
+        void set_format(const std::string& symbol="Q",
+                        const std::string& sep1=".",
+                        const std::string& sep2=".",
+                        const std::string& sep3="",
+                        const std::string& section="cross.section");
+
+        // accepted (inclusive) index range of the coefficients
+        void set_index_range(std::size_t index_min, std::size_t index_max);
+
+        int parse(const std::string& filename);
+        int parse_string(const std::string& content, const std::string& source_name="input");
+
+        const std::vector<key_value>& header() const { return fHeader; }
+        const cross_section_table& coefficients() const { return fCoefficients; }
+        cross_section_table& coefficients() { return fCoefficients; }
+        const std::map<std::size_t,double>& initial_conditions() const { return fInitial_conditions; }
+
+        // index ranges of the coefficients found in the file (i = first index, j = second index)
+        std::size_t index_i_min() const { return fIndex_i_min; }
+        std::size_t index_i_max() const { return fIndex_i_max; }
+        std::size_t index_j_min() const { return fIndex_j_min; }
+        std::size_t index_j_max() const { return fIndex_j_max; }
+
+    private:
+        int store(const std::string& key, const std::string& value, const std::string& source_name, std::size_t line_number);
+        // too_large : an index exceeds the max. of the index range
+        bool match_coef_key(const std::string& key, std::size_t& i, std::size_t& j, bool& too_large) const;
+        bool match_init_cond_key(const std::string& key, std::size_t& i, bool& too_large) const;
+
+        std::string fCoef_prefix;
+        std::string fCoef_sep;
+        std::string fInit_cond_prefix;
+        std::string fInit_cond_suffix;
+
+        std::size_t fRange_min;
+        std::size_t fRange_max;
+
+        std::vector<key_value> fHeader;
+        std::vector<std::tuple<std::size_t,std::size_t,double> > fEntries;
+        cross_section_table fCoefficients;
+        std::map<std::size_t,double> fInitial_conditions;
+
+        std::size_t fIndex_i_min;
+        std::size_t fIndex_i_max;
+        std::size_t fIndex_j_min;
+        std::size_t fIndex_j_max;
+    };
+}
+
+#endif	/* CROSS_SECTION_PARSER_H */
+
@@ -38,7 +38,10 @@ class bear_summary
                         equilibrium_solutions(), 
                         analytical_solutions(),max_fraction_index(0),
                         system_dim(0), 
-                        reduced_system_dim(0) , offset(0)
+                        reduced_system_dim(0) , offset(0),
+                        thickness_minimum(0.),
+                        thickness_maximum(0.),
+                        thickness_point_number(0)
     {}
     virtual ~bear_summary (){}
 
@@ -58,6 +61,11 @@ class bear_summary
     std::size_t reduced_system_dim;
     std::size_t offset;
 
+    // thickness grid of the non-equilibrium table
+    double thickness_minimum;
+    double thickness_maximum;
+    std::size_t thickness_point_number;
+
 };
 
 namespace bear
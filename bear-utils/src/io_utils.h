@@ -0,0 +1,119 @@
+/*
+ * File:   io_utils.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef IO_UTILS_H
+#define	IO_UTILS_H
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "def.h"
+#include "table_writer.h"
+#include "logger.h"
+
+// input files and text fields (json, csv) shared by the results writers and the programs
+// that solve many systems (bear-batch, bear-sweep, bear-serve)
+namespace bear
+{
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// input files, in the given order : the files themselves, or the .txt files of //
+    /// the directories (sorted)                                                     //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline int collect_inputs(const std::vector<std::string>& names, std::vector<fs::path>& inputs)
+    {
+        for(const auto& name : names)
+        {
+            fs::path path(name);
+            if(fs::is_directory(path))
+            {
+                std::vector<fs::path> files;
+                for(fs::directory_iterator it(path); it!=fs::directory_iterator(); ++it)
+                    if(fs::is_regular_file(it->status()) && it->path().extension()==".txt")
+                        files.push_back(it->path());
+                std::sort(files.begin(),files.end());
+                inputs.insert(inputs.end(),files.begin(),files.end());
+            }
+            else if(fs::is_regular_file(path))
+                inputs.push_back(path);
+            else
+            {
+                LOG(ERROR)<<"input '"<<name<<"' not found";
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// json string : quotes, backslashes and control characters escaped            //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline std::string json_string(const std::string& str)
+    {
+        std::string json="\"";
+        for(char c : str)
+        {
+            switch(c)
+            {
+                case '"' :  json+="\\\""; break;
+                case '\\' : json+="\\\\"; break;
+                case '\n' : json+="\\n"; break;
+                case '\t' : json+="\\t"; break;
+                case '\r' : json+="\\r"; break;
+                default :
+                    if(static_cast<unsigned char>(c)<0x20)
+                    {
+                        char buffer[8];
+                        std::snprintf(buffer,sizeof(buffer),"\\u%04x",static_cast<unsigned int>(c));
+                        json+=buffer;
+                    }
+                    else
+                        json+=c;
+            }
+        }
+        json+="\"";
+        return json;
+    }
+
+    // shortest representation that reads back to the same double (null if not finite)
+    inline std::string json_number(double value)
+    {
+        if(!std::isfinite(value))
+            return "null";
+        char buffer[32];
+        int n=table_writer::format_round_trip(value,buffer);
+        return std::string(buffer,n>0 ? n : 0);
+    }
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// csv fields                                                                   //
+    /// //////////////////////////////////////////////////////////////////////////////
+    inline std::string csv_number(double value)
+    {
+        char buffer[32];
+        int n=table_writer::format_round_trip(value,buffer);
+        return std::string(buffer,n>0 ? n : 0);
+    }
+
+    // quoted field, the quotes of str doubled
+    inline std::string csv_quoted(const std::string& str)
+    {
+        std::string field="\"";
+        for(char c : str)
+        {
+            if(c=='"')
+                field+='"';
+            field+=c;
+        }
+        return field+"\"";
+    }
+}
+
+#endif	/* IO_UTILS_H */
@@ -0,0 +1,182 @@
+/*
+ * File:   log_ring_queue.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef LOG_RING_QUEUE_H
+#define	LOG_RING_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include <boost/log/core/record_view.hpp>
+
+/// //////////////////////////////////////////////////////////////////////////////////
+/// Queueing strategy of boost::log::sinks::asynchronous_sink : bounded lock-free ring //
+/// buffer of log records (multi-producer, D. Vyukov's bounded queue). The records    //
+/// are already formatted by the producers (message), the sink thread pops them and   //
+/// does the formatting of the line (time stamp, severity) and the I/O.               //
+///                                                                                   //
+/// A producer only takes a lock to wake up the sink thread when it is sleeping on an //
+/// empty ring. When the ring is full, the producer yields until the sink thread has  //
+/// freed a slot (it never does any I/O itself).                                      //
+/// //////////////////////////////////////////////////////////////////////////////////
+class log_ring_queue
+{
+    typedef boost::log::record_view record_view;
+
+    struct cell
+    {
+        std::atomic<std::size_t> sequence;
+        record_view record;
+    };
+
+    static const std::size_t capacity=8192;    // power of 2
+
+protected:
+    log_ring_queue() :  fCells(capacity), fEnqueue_pos(0), fDequeue_pos(0),
+                        fSleeping(false), fInterrupted(false), fMutex(), fCondition()
+    {
+        for(std::size_t i(0); i<capacity; i++)
+            fCells[i].sequence.store(i,std::memory_order_relaxed);
+    }
+
+    template<typename ArgsT>
+    explicit log_ring_queue(ArgsT const&) : log_ring_queue()
+    {}
+
+    void enqueue(record_view const& rec)
+    {
+        while(!push(rec))
+            std::this_thread::yield();
+        wake_up();
+    }
+
+    bool try_enqueue(record_view const& rec)
+    {
+        if(!push(rec))
+            return false;
+        wake_up();
+        return true;
+    }
+
+    bool try_dequeue_ready(record_view& rec)
+    {
+        return pop(rec);
+    }
+
+    bool try_dequeue(record_view& rec)
+    {
+        return pop(rec);
+    }
+
+    // block until a record is available, or until interrupt_dequeue is called
+    bool dequeue_ready(record_view& rec)
+    {
+        while(true)
+        {
+            if(pop(rec))
+                return true;
+
+            std::unique_lock<std::mutex> lock(fMutex);
+            fSleeping.store(true,std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // a record pushed before fSleeping was set did not wake us up : check again
+            if(pop(rec))
+            {
+                fSleeping.store(false,std::memory_order_relaxed);
+                return true;
+            }
+            if(!fInterrupted)
+                fCondition.wait_for(lock,std::chrono::milliseconds(50));
+            fSleeping.store(false,std::memory_order_relaxed);
+            if(fInterrupted)
+            {
+                fInterrupted=false;
+                return false;
+            }
+        }
+    }
+
+    void interrupt_dequeue()
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fInterrupted=true;
+        fCondition.notify_one();
+    }
+
+private:
+    bool push(record_view const& rec)
+    {
+        std::size_t pos=fEnqueue_pos.load(std::memory_order_relaxed);
+        while(true)
+        {
+            cell& c=fCells[pos & (capacity-1)];
+            std::size_t sequence=c.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff=static_cast<std::ptrdiff_t>(sequence)-static_cast<std::ptrdiff_t>(pos);
+            if(diff==0)
+            {
+                if(fEnqueue_pos.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed))
+                {
+                    c.record=rec;
+                    c.sequence.store(pos+1,std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(diff<0)
+                return false;// full
+            else
+                pos=fEnqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool pop(record_view& rec)
+    {
+        std::size_t pos=fDequeue_pos.load(std::memory_order_relaxed);
+        while(true)
+        {
+            cell& c=fCells[pos & (capacity-1)];
+            std::size_t sequence=c.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff=static_cast<std::ptrdiff_t>(sequence)-static_cast<std::ptrdiff_t>(pos+1);
+            if(diff==0)
+            {
+                if(fDequeue_pos.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed))
+                {
+                    rec.swap(c.record);
+                    c.record.reset();
+                    c.sequence.store(pos+capacity,std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(diff<0)
+                return false;// empty
+            else
+                pos=fDequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    void wake_up()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(fSleeping.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fCondition.notify_one();
+        }
+    }
+
+    std::vector<cell> fCells;
+    std::atomic<std::size_t> fEnqueue_pos;
+    std::atomic<std::size_t> fDequeue_pos;
+    std::atomic<bool> fSleeping;            // the sink thread waits for records
+    bool fInterrupted;
+    std::mutex fMutex;
+    std::condition_variable fCondition;
+};
+
+#endif	/* LOG_RING_QUEUE_H */
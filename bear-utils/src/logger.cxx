@@ -11,6 +11,7 @@
 #include <boost/log/expressions/formatters/date_time.hpp>
 #include <boost/log/expressions.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
 #include <boost/log/sources/severity_logger.hpp>
 #include <boost/log/support/date_time.hpp>
@@ -21,6 +22,12 @@
 #include <boost/shared_ptr.hpp>
 #include <fstream>
 #include <ostream>
+#include <mutex>
+#include <vector>
+#include <cstdlib>
+#include <exception>
+
+#include "log_ring_queue.h"
 
 
 
@@ -41,13 +48,97 @@ BOOST_LOG_GLOBAL_LOGGER_INIT(global_logger, src::severity_logger_mt)
 }
 
 typedef sinks::synchronous_sink<sinks::text_ostream_backend> text_sink;
+// text backend of the asynchronous sinks : the streams are flushed after the error records, 
+// so that the records up to an error are in the file even if the program does not exit normally
+class error_flushing_backend : public sinks::text_ostream_backend
+{
+public:
+    void consume(logging::record_view const& rec, string_type const& formatted_message)
+    {
+        sinks::text_ostream_backend::consume(rec,formatted_message);
+        logging::value_ref<custom_severity_level,tag::severity> level=rec[severity];
+        if(level && level.get()>=custom_severity_level::ERROR)
+            flush();
+    }
+};
+
+typedef sinks::asynchronous_sink<error_flushing_backend,log_ring_queue> async_text_sink;
+typedef sinks::basic_formatting_sink_frontend<char> formatting_sink;
+
+namespace
+{
+    bool g_async_log=false;
+    std::mutex g_async_sinks_mutex;
+    std::vector<boost::shared_ptr<async_text_sink> > g_async_sinks;
+    std::terminate_handler g_previous_terminate=nullptr;
+    
+    // text sink writing to stream : synchronous, or asynchronous (see set_log_async)
+    boost::shared_ptr<formatting_sink> make_text_sink(const boost::shared_ptr<std::ostream>& stream)
+    {
+        if(!g_async_log)
+        {
+            boost::shared_ptr<text_sink> sink = boost::make_shared<text_sink>();
+            sink->locked_backend()->add_stream(stream);
+            return sink;
+        }
+        
+        boost::shared_ptr<error_flushing_backend> backend = boost::make_shared<error_flushing_backend>();
+        backend->add_stream(stream);
+        boost::shared_ptr<async_text_sink> sink = boost::make_shared<async_text_sink>(backend);
+        std::lock_guard<std::mutex> lock(g_async_sinks_mutex);
+        g_async_sinks.push_back(sink);
+        return sink;
+    }
+    
+    // write the queued records, stop the sink threads and remove the sinks from the core
+    void stop_async_sinks()
+    {
+        std::lock_guard<std::mutex> lock(g_async_sinks_mutex);
+        for(auto& sink : g_async_sinks)
+        {
+            logging::core::get()->remove_sink(sink);
+            sink->stop();
+            sink->flush();
+        }
+        g_async_sinks.clear();
+    }
+    
+    void flush_log_and_terminate()
+    {
+        flush_log();
+        if(g_previous_terminate)
+            g_previous_terminate();
+        std::abort();
+    }
+}
+
+void set_log_async(bool async)
+{
+    g_async_log=async;
+    static bool handlers_installed=false;
+    if(async && !handlers_installed)
+    {
+        // the core must outlive the exit handler : create it before registering the handler
+        logging::core::get();
+        std::atexit(&stop_async_sinks);
+        g_previous_terminate=std::set_terminate(&flush_log_and_terminate);
+        handlers_installed=true;
+    }
+}
+
+void flush_log()
+{
+    std::lock_guard<std::mutex> lock(g_async_sinks_mutex);
+    for(auto& sink : g_async_sinks)
+        sink->flush();
+}
+
 void init_log_console()
 {
     // add a text sink
     
-    boost::shared_ptr<text_sink> sink = boost::make_shared<text_sink>();
     // add "console" output stream to our sink
-    sink->locked_backend()->add_stream(boost::shared_ptr<std::ostream>(&std::clog, boost::null_deleter()));
+    boost::shared_ptr<formatting_sink> sink = make_text_sink(boost::shared_ptr<std::ostream>(&std::clog, boost::null_deleter()));
     // specify the format of the log message 
     sink->set_formatter(&init_log_formatter<tag_console>);
     // add sink to the core
@@ -59,10 +150,10 @@ void init_log_console(custom_severity_level threshold, log_op::operation op)
 {
     // add a text sink
     //typedef sinks::synchronous_sink<sinks::text_ostream_backend> text_sink;
+    stop_async_sinks();
     logging::core::get()->remove_all_sinks();
-    boost::shared_ptr<text_sink> sink = boost::make_shared<text_sink>();
     // add "console" output stream to our sink
-    sink->locked_backend()->add_stream(boost::shared_ptr<std::ostream>(&std::clog, boost::null_deleter()));
+    boost::shared_ptr<formatting_sink> sink = make_text_sink(boost::shared_ptr<std::ostream>(&std::clog, boost::null_deleter()));
     // specify the format of the log message 
     sink->set_formatter(&init_log_formatter<tag_console>);
     // add sink to the core
@@ -124,9 +215,7 @@ void init_log_file(const std::string& filename, custom_severity_level threshold,
     */
     
     
-    typedef sinks::synchronous_sink<sinks::text_ostream_backend> text_sink;
-    boost::shared_ptr<text_sink> sink = boost::make_shared<text_sink>();
-    sink->locked_backend()->add_stream(boost::make_shared<std::ofstream>(filename));
+    boost::shared_ptr<formatting_sink> sink = make_text_sink(boost::make_shared<std::ofstream>(filename));
     
     // specify the format of the log message 
     sink->set_formatter(&init_log_formatter<tag_file>);
@@ -187,9 +276,7 @@ void init_new_file(const std::string& filename, custom_severity_level threshold,
     */
     
     //sink->set_formatter(&init_file_formatter);
-    typedef sinks::synchronous_sink<sinks::text_ostream_backend> text_sink;
-    boost::shared_ptr<text_sink> sink = boost::make_shared<text_sink>();
-    sink->locked_backend()->add_stream(boost::make_shared<std::ofstream>(filename));
+    boost::shared_ptr<formatting_sink> sink = make_text_sink(boost::make_shared<std::ofstream>(filename));
 
     switch (op)
     {
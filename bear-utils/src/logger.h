@@ -67,6 +67,13 @@ void init_new_file( const std::string& filename,
                     log_op::operation op
                    );
 
+// asynchronous logging : the sinks created afterwards queue the records in a lock-free
+// ring, and a thread per sink does the formatting and the I/O. The queued records are 
+// written at exit (and on std::terminate)
+void set_log_async(bool async);
+// write the queued records (asynchronous logging)
+void flush_log();
+
 void set_global_log_level(  log_op::operation op=log_op::GREATER_EQ_THAN, 
                             custom_severity_level threshold=SEVERITY_THRESHOLD );
 void set_global_log_level_operation(  log_op::operation op=log_op::GREATER_EQ_THAN, 
@@ -103,8 +110,10 @@ void init_log_formatter(const boost::log::record_view &view, boost::log::formatt
 }
 
 // helper macros 
-#define LOG(severity) BOOST_LOG_SEV(global_logger::get(),custom_severity_level::severity)
-#define MQLOG(severity) BOOST_LOG_SEV(global_logger::get(),custom_severity_level::severity)
+// (the loop runs once, or never below SEVERITY_FLOOR : the condition is a constant, so the statement
+// and its arguments are dead code there. A for loop, unlike if/else, is safe in an unbraced if)
+#define LOG(severity) for(bool bear_log_on_=!(custom_severity_level::severity<SEVERITY_FLOOR); bear_log_on_; bear_log_on_=false) BOOST_LOG_SEV(global_logger::get(),custom_severity_level::severity)
+#define MQLOG(severity) for(bool bear_log_on_=!(custom_severity_level::severity<SEVERITY_FLOOR); bear_log_on_; bear_log_on_=false) BOOST_LOG_SEV(global_logger::get(),custom_severity_level::severity)
 #define SET_LOG_LEVEL(loglevel) boost::log::core::get()->set_filter(severity >= custom_severity_level::loglevel);
 #define SET_LOG_FILTER(logfilter)  boost::log::core::get()->set_filter(severity == custom_severity_level::logfilter);
 
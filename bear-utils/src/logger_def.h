@@ -91,6 +91,13 @@ inline std::string write_in(const std::string& text_in_bold)
 typedef bear::severity_level custom_severity_level;
 #define SEVERITY_THRESHOLD custom_severity_level::MAXDEBUG
 
+// compile-time floor of the severity (cmake option BEAR_LOG_FLOOR) : the LOG(severity)
+// statements below the floor are removed by the compiler, the filters apply above it
+#ifndef BEAR_LOG_FLOOR
+#define BEAR_LOG_FLOOR MAXDEBUG
+#endif
+#define SEVERITY_FLOOR custom_severity_level::BEAR_LOG_FLOOR
+
 // tags used for log console or file formatting
 struct tag_console;
 struct tag_file;
@@ -0,0 +1,444 @@
+/*
+ * File:   results_writer.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef RESULTS_WRITER_H
+#define	RESULTS_WRITER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+
+#include "table_writer.h"
+#include "binary_writer.h"
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Results channel : the results of a run (equilibrium fractions, analytical   //
+    /// formulae, table) are written through this typed interface, independently of //
+    /// the logging framework (no time stamp, no severity filter, the log           //
+    /// configuration cannot change the result files). Backends :                  //
+    ///   text       : the Bear-results-<input>.txt file                            //
+    ///   csv        : one csv file per quantity, numbers in round-trip form        //
+    ///   npy / raw  : float64 arrays with a json header (binary_writer)            //
+    /// All functions return 0 on success, 1 on I/O error.                          //
+    /// //////////////////////////////////////////////////////////////////////////////
+    class results_writer
+    {
+    public:
+        enum fractions_type {kEquilibrium,kApproximation};
+
+        struct run_info
+        {
+            std::string title;
+            std::string input_file;
+            std::size_t system_dim;
+            std::size_t max_fraction_index;
+            std::vector<int> charge_states;     // charge of each level
+            std::string sampling;
+            std::string input_json;             // header of the input file as a json object
+        };
+
+        struct table_info
+        {
+            std::string unit;                   // thickness unit
+            double minimum;                     // thickness range and point number of the input file
+            double maximum;
+            std::size_t point_number;
+            std::vector<int> charge_states;
+        };
+
+        virtual ~results_writer(){}
+
+        virtual int write_run(const run_info& info)=0;
+        // fractions of each level, in the order of info.charge_states
+        virtual int write_fractions(fractions_type type, const std::vector<int>& charge_states, const std::vector<double>& fractions)=0;
+        virtual int write_formulae(const std::vector<int>& charge_states, const std::vector<std::string>& formulae)=0;
+        // x (points values) and F (levels x points, column major : the fractions at x[k] are
+        // contiguous, starting at F+k*levels)
+        virtual int write_table(const table_info& info, const double* x, const double* F, std::size_t levels, std::size_t points)=0;
+        virtual int close()=0;
+
+        // file (text) or file prefix (csv, npy, raw) of the results
+        virtual std::string location() const=0;
+
+        static const char* fractions_name(fractions_type type)
+        {
+            return type==kEquilibrium ? "equilibrium" : "approximation";
+        }
+    };
+
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// text backend : results file with banners, the table is written by blocks     //
+    /// by table_writer                                                              //
+    /// //////////////////////////////////////////////////////////////////////////////
+    class text_results_writer : public results_writer
+    {
+    public:
+        text_results_writer(const std::string& filename, table_writer::format table_format=table_writer::kScientific) :
+                                fFilename(filename), fTable_format(table_format),
+                                fFile(filename.c_str(),std::ios::out|std::ios::trunc), fNon_equilibrium(false)
+        {}
+        virtual ~text_results_writer(){}
+
+        virtual int write_run(const run_info& info)
+        {
+            line(" ");
+            line("##########################################################################");
+            line("#                          BEAR  -  RESULTS                              #");
+            line("##########################################################################");
+            line(" ");
+            fFile<<"Title : "<<info.title<<"\n";
+            line(" ");
+            fFile<<"Computed from input file : "<<info.input_file<<"\n";
+            line(" ");
+            fFile<<"Found a "<<info.system_dim<<" level system\n";
+            line(" ");
+            return status();
+        }
+
+        virtual int write_fractions(fractions_type type, const std::vector<int>& charge_states, const std::vector<double>& fractions)
+        {
+            if(type==kEquilibrium)
+            {
+                line("##########################################################################");
+                line("#                EQUILIBRIUM CHARGE STATE DISTRIBUTION                   #");
+                line("##########################################################################");
+            }
+            else
+            {
+                line(" ");
+                line("##########################################################################");
+                line("#  EQUILIBRIUM CHARGE STATE DISTRIBUTION  (1-electron approximation)     #");
+                line("##########################################################################");
+            }
+            line(" ");
+            double sum=0;
+            double mean=0;
+            for(std::size_t i(0); i<fractions.size(); i++)
+            {
+                mean+=charge_states[i]*fractions[i];
+                sum+=fractions[i];
+                fFile<<"F"<<charge_states[i]<<" = "<<fractions[i]<<"\n";
+            }
+            fFile<<"sum = "<<sum<<"\n";
+            fFile<<"<q> = "<<mean<<"\n";
+            return status();
+        }
+
+        virtual int write_formulae(const std::vector<int>& charge_states, const std::vector<std::string>& formulae)
+        {
+            begin_non_equilibrium();
+            line("##################################");
+            line("#computed analytical formulae :");
+            for(std::size_t i(0); i<formulae.size(); i++)
+            {
+                line(" ");
+                fFile<<"F"<<charge_states[i]<<"(x) = "<<formulae[i]<<"\n";
+                line(" ");
+            }
+            return status();
+        }
+
+        virtual int write_table(const table_info& info, const double* x, const double* F, std::size_t levels, std::size_t points)
+        {
+            begin_non_equilibrium();
+            line(" ");
+            line("##################################");
+            line("#TABLE :");
+            fFile<<"X unit : "<<info.unit<<"\n";
+            fFile<<"X range : "<<info.minimum<<" - "<<info.maximum<<"\n";
+            fFile<<"Point number : "<<info.point_number<<"\n";
+
+            std::ofstream& file=fFile;
+            table_writer writer([&file](const std::string& block){ file<<block<<'\n'; },fTable_format);
+            std::vector<std::string> labels(1,"X");
+            for(std::size_t i(0); i<levels; i++)
+                labels.push_back("F"+std::to_string(i+1));
+            labels.push_back("Sum");
+            writer.write_header(labels);
+            for(std::size_t k(0); k<points; k++)
+                writer.write_row(x[k],F+k*levels,levels);
+            writer.flush();
+            return status();
+        }
+
+        virtual int close()
+        {
+            fFile.close();
+            return fFile.fail() ? 1 : 0;
+        }
+
+        virtual std::string location() const { return fFilename; }
+
+    private:
+        void line(const char* text)
+        {
+            fFile<<text<<"\n";
+        }
+
+        // banner written once, before the formulae or the table
+        void begin_non_equilibrium()
+        {
+            if(fNon_equilibrium)
+                return;
+            fNon_equilibrium=true;
+            line(" ");
+            line("##########################################################################");
+            line("#             NON-EQUILIBRIUM CHARGE STATE DISTRIBUTION                  #");
+            line("##########################################################################");
+            line(" ");
+        }
+
+        int status() const
+        {
+            return fFile ? 0 : 1;
+        }
+
+        std::string fFilename;
+        table_writer::format fTable_format;
+        std::ofstream fFile;
+        bool fNon_equilibrium;              // non-equilibrium banner already written
+    };
+
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// csv backend : prefix-run.csv (key,value), prefix-equilibrium.csv and         //
+    /// prefix-approximation.csv (charge,fraction), prefix-analytic.csv              //
+    /// (charge,formula) and prefix-table.csv (x,F<q>...,sum). The numbers are       //
+    /// written in the short form that reads back to the same double.               //
+    /// //////////////////////////////////////////////////////////////////////////////
+    class csv_results_writer : public results_writer
+    {
+    public:
+        csv_results_writer(const std::string& prefix) : fPrefix(prefix)
+        {}
+        virtual ~csv_results_writer(){}
+
+        virtual int write_run(const run_info& info)
+        {
+            std::ofstream file;
+            if(open(file,"run"))
+                return 1;
+            file<<"key,value\n";
+            file<<"title,"<<quoted(info.title)<<"\n";
+            file<<"input_file,"<<quoted(info.input_file)<<"\n";
+            file<<"system_dim,"<<info.system_dim<<"\n";
+            file<<"max_fraction_index,"<<info.max_fraction_index<<"\n";
+            file<<"sampling,"<<quoted(info.sampling)<<"\n";
+            return file ? 0 : 1;
+        }
+
+        virtual int write_fractions(fractions_type type, const std::vector<int>& charge_states, const std::vector<double>& fractions)
+        {
+            std::ofstream file;
+            if(open(file,fractions_name(type)))
+                return 1;
+            file<<"charge,fraction\n";
+            for(std::size_t i(0); i<fractions.size(); i++)
+                file<<charge_states[i]<<","<<number(fractions[i])<<"\n";
+            return file ? 0 : 1;
+        }
+
+        virtual int write_formulae(const std::vector<int>& charge_states, const std::vector<std::string>& formulae)
+        {
+            std::ofstream file;
+            if(open(file,"analytic"))
+                return 1;
+            file<<"charge,formula\n";
+            for(std::size_t i(0); i<formulae.size(); i++)
+                file<<charge_states[i]<<","<<quoted(formulae[i])<<"\n";
+            return file ? 0 : 1;
+        }
+
+        virtual int write_table(const table_info& info, const double* x, const double* F, std::size_t levels, std::size_t points)
+        {
+            std::ofstream file;
+            if(open(file,"table"))
+                return 1;
+            std::string buffer="x";
+            for(std::size_t i(0); i<levels; i++)
+                buffer+=",F"+std::to_string(i<info.charge_states.size() ? info.charge_states[i] : static_cast<int>(i+1));
+            buffer+=",sum\n";
+
+            // rows formatted into one buffer, written by blocks of 1 MB
+            const std::size_t block_size=1<<20;
+            for(std::size_t k(0); k<points; k++)
+            {
+                append(buffer,x[k]);
+                double sum=0.;
+                for(std::size_t i(0); i<levels; i++)
+                {
+                    buffer+=',';
+                    append(buffer,F[k*levels+i]);
+                    sum+=F[k*levels+i];
+                }
+                buffer+=',';
+                append(buffer,sum);
+                buffer+='\n';
+                if(buffer.size()>=block_size)
+                {
+                    file.write(buffer.data(),buffer.size());
+                    buffer.clear();
+                }
+            }
+            file.write(buffer.data(),buffer.size());
+            return file ? 0 : 1;
+        }
+
+        virtual int close()
+        {
+            return 0;
+        }
+
+        virtual std::string location() const { return fPrefix+"-*.csv"; }
+
+    private:
+        int open(std::ofstream& file, const std::string& name)
+        {
+            std::string filename=fPrefix+"-"+name+".csv";
+            file.open(filename.c_str(),std::ios::out|std::ios::trunc);
+            return file ? 0 : 1;
+        }
+
+        static void append(std::string& buffer, double value)
+        {
+            char str[32];
+            int n=table_writer::format_round_trip(value,str);
+            buffer.append(str,n>0 ? static_cast<std::size_t>(n) : 0);
+        }
+
+        static std::string number(double value)
+        {
+            std::string str;
+            append(str,value);
+            return str;
+        }
+
+        // csv field, quotes doubled
+        static std::string quoted(const std::string& str)
+        {
+            std::string field="\"";
+            for(char c : str)
+            {
+                if(c=='"')
+                    field+='"';
+                field+=c;
+            }
+            field+="\"";
+            return field;
+        }
+
+        std::string fPrefix;
+    };
+
+
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// npy / raw backend : arrays (equilibrium, approximation, thickness,          //
+    /// fractions, mean_charge) and prefix.json, written by binary_writer            //
+    /// //////////////////////////////////////////////////////////////////////////////
+    class binary_results_writer : public results_writer
+    {
+    public:
+        binary_results_writer(const std::string& prefix, binary_writer::format fmt) : fWriter(prefix,fmt)
+        {}
+        virtual ~binary_results_writer(){}
+
+        virtual int write_run(const run_info& info)
+        {
+            fWriter.add_metadata("title",info.title);
+            fWriter.add_metadata("input_file",info.input_file);
+            fWriter.add_metadata("system_dim",info.system_dim);
+            fWriter.add_metadata("max_fraction_index",info.max_fraction_index);
+            fWriter.add_metadata("charge_states",info.charge_states);
+            fWriter.add_metadata_json("input",info.input_json);
+            fWriter.add_metadata("sampling",info.sampling);
+            return 0;
+        }
+
+        // the charge states of the array and the mean charge <q> are added to the metadata
+        virtual int write_fractions(fractions_type type, const std::vector<int>& charge_states, const std::vector<double>& fractions)
+        {
+            if(fractions.empty())
+                return 0;
+            const std::string name=fractions_name(type);
+            double mean=0;
+            for(std::size_t i(0); i<fractions.size() && i<charge_states.size(); i++)
+                mean+=charge_states[i]*fractions[i];
+            fWriter.add_metadata(name+"_charge_states",charge_states);
+            fWriter.add_metadata(name+"_mean_charge",mean);
+            return fWriter.write_array(name,&fractions[0],{fractions.size()});
+        }
+
+        virtual int write_formulae(const std::vector<int>& charge_states, const std::vector<std::string>& formulae)
+        {
+            std::string json="{";
+            for(std::size_t i(0); i<formulae.size(); i++)
+            {
+                if(i>0)
+                    json+=", ";
+                json+=json_string("F"+std::to_string(charge_states[i]));
+                json+=": "+json_string(formulae[i]);
+            }
+            json+="}";
+            fWriter.add_metadata_json("analytical_solutions",json);
+            return 0;
+        }
+
+        // the column major levels x points table is the C order array of shape (points,levels)
+        virtual int write_table(const table_info& info, const double* x, const double* F, std::size_t levels, std::size_t points)
+        {
+            std::vector<double> mean_charge(points,0.);
+            for(std::size_t k(0); k<points; k++)
+                for(std::size_t i(0); i<levels && i<info.charge_states.size(); i++)
+                    mean_charge[k]+=info.charge_states[i]*F[k*levels+i];
+
+            fWriter.add_metadata("thickness_unit",info.unit);
+            if(fWriter.write_array("thickness",x,{points})
+                || fWriter.write_array("fractions",F,{points,levels})
+                || fWriter.write_array("mean_charge",&mean_charge[0],{points}))
+                return 1;
+            return 0;
+        }
+
+        virtual int close()
+        {
+            return fWriter.write_header();
+        }
+
+        virtual std::string location() const { return fWriter.header_filename(); }
+
+    private:
+        binary_writer fWriter;
+    };
+
+
+
+    // results writer of the given output format (text, csv, npy or raw), null if the format
+    // is unknown. The files are named prefix.txt (text) or prefix-<name>.<extension>
+    inline std::unique_ptr<results_writer> make_results_writer(const std::string& format,
+                                                               const std::string& prefix,
+                                                               table_writer::format table_format=table_writer::kScientific)
+    {
+        std::unique_ptr<results_writer> writer;
+        binary_writer::format binary_format;
+        if(format=="text")
+            writer.reset(new text_results_writer(prefix+".txt",table_format));
+        else if(format=="csv")
+            writer.reset(new csv_results_writer(prefix));
+        else if(!binary_writer::parse_format(format,binary_format))
+            writer.reset(new binary_results_writer(prefix,binary_format));
+        return writer;
+    }
+}
+
+#endif	/* RESULTS_WRITER_H */
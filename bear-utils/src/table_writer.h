@@ -0,0 +1,467 @@
+/*
+ * File:   table_writer.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef TABLE_WRITER_H
+#define	TABLE_WRITER_H
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace bear
+{
+
+    /// //////////////////////////////////////////////////////////////////////////////
+    /// Text table writer : rows of centered fixed width columns separated by 4     //
+    /// spaces (x, F_1 ... F_N, sum), as in the text results file. The cells are    //
+    /// formatted in place into one reusable buffer (no allocation per cell or per  //
+    /// row), which is passed to the sink when it exceeds the block size : large    //
+    /// tables are written with a few calls. The buffer holds complete lines,       //
+    /// separated by '\n' (no trailing newline).                                    //
+    ///                                                                             //
+    /// Number formats :                                                            //
+    ///   scientific : printf "%e" (7 significant digits), columns of 16 characters //
+    ///   round-trip : shortest "%e" form that reads back to the same double (at    //
+    ///                most 17 significant digits, Grisu3), columns of 24 characters//
+    /// //////////////////////////////////////////////////////////////////////////////
+    class table_writer
+    {
+    public:
+        enum format {kScientific,kRoundTrip};
+        typedef std::function<void(const std::string&)> sink_type;
+
+        table_writer(sink_type sink, format fmt=kScientific, std::size_t block_size=1<<20) :
+                                fSink(sink), fFormat(fmt), fWidth(fmt==kRoundTrip ? 24 : 16),
+                                fBlock_size(block_size), fBuffer()
+        {
+            fBuffer.reserve(fBlock_size+1024);
+        }
+        virtual ~table_writer()
+        {
+            flush();
+        }
+
+        // "scientific" or "round-trip", return 1 if unknown
+        static int parse_format(const std::string& name, format& fmt)
+        {
+            if(name=="scientific")
+                fmt=kScientific;
+            else if(name=="round-trip")
+                fmt=kRoundTrip;
+            else
+                return 1;
+            return 0;
+        }
+
+        std::size_t width() const { return fWidth; }
+
+        // column titles, centered as the values
+        void write_header(const std::vector<std::string>& labels)
+        {
+            new_line();
+            for(std::size_t i(0); i<labels.size(); i++)
+            {
+                if(i>0)
+                    fBuffer.append(4,' ');
+                append_centered(labels[i].data(),labels[i].size());
+            }
+            end_line();
+        }
+
+        // x, F(x) (level_number values) and their sum
+        void write_row(double x, const double* F, std::size_t level_number)
+        {
+            new_line();
+            append_value(x);
+            double sum=0.;
+            for(std::size_t i(0); i<level_number; i++)
+            {
+                fBuffer.append(4,' ');
+                append_value(F[i]);
+                sum+=F[i];
+            }
+            fBuffer.append(4,' ');
+            append_value(sum);
+            end_line();
+        }
+
+        void flush()
+        {
+            if(fBuffer.empty())
+                return;
+            fSink(fBuffer);
+            fBuffer.clear();
+        }
+
+        // write value in str (at least 32 char) as printf "%e" and return the length. The 7
+        // significant digits are obtained by scaling with exact powers of ten : the rounding is
+        // delegated to snprintf only when the scaled value is too close to a tie to be decided
+        // in double precision (and for inf, nan, denormals).
+        static int format_scientific(double value, char* str)
+        {
+            static const double pow10[23]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+                                           1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+            auto scale=[](double a, int n)
+            {
+                for(; n>22; n-=22)
+                    a*=pow10[22];
+                for(; n<-22; n+=22)
+                    a/=pow10[22];
+                return n>=0 ? a*pow10[n] : a/pow10[-n];
+            };
+
+            double a=std::fabs(value);
+            if(a==0.)
+                return std::snprintf(str,32,std::signbit(value) ? "-0.000000e+00" : "0.000000e+00");
+            if(!(a>=1e-290 && a<1e300))
+                return std::snprintf(str,32,"%e",value);
+
+            int e=static_cast<int>(std::floor(std::log10(a)));
+            double t=scale(a,6-e);
+            if(t<1e6)
+                t=scale(a,6-(--e));
+            else if(t>=1e7)
+                t=scale(a,6-(++e));
+
+            double digits=std::floor(t);
+            double frac=t-digits;
+            if(std::fabs(frac-0.5)<1e-6)
+                return std::snprintf(str,32,"%e",value);
+            long q=static_cast<long>(digits)+(frac>0.5 ? 1 : 0);
+            if(q>=10000000)
+            {
+                q=1000000;
+                ++e;
+            }
+
+            char* c=str;
+            if(value<0)
+                *c++='-';
+            *c++=static_cast<char>('0'+q/1000000);
+            *c++='.';
+            for(long d=100000; d>0; d/=10)
+                *c++=static_cast<char>('0'+(q/d)%10);
+            *c++='e';
+            *c++= e<0 ? '-' : '+';
+            int abs_e= e<0 ? -e : e;
+            if(abs_e>=100)
+                *c++=static_cast<char>('0'+abs_e/100);
+            *c++=static_cast<char>('0'+(abs_e/10)%10);
+            *c++=static_cast<char>('0'+abs_e%10);
+            *c='\0';
+            return static_cast<int>(c-str);
+        }
+
+        // shortest "%e" representation of value that reads back to value, the closest to value
+        // if several have the same length. The digits are produced in one pass by Grisu3
+        // (shortest_digits); in the rare cases it cannot decide, "%.14e" then "%.15e" (15 and
+        // 16 significant digits, each correctly rounded by printf) are kept if they read back
+        // to value, otherwise the 17 digits of "%.16e", which always do. Values with a short
+        // decimal form are written with it (0.1 -> 1e-01).
+        static int format_round_trip(double value, char* str)
+        {
+            if(!std::isfinite(value))
+                return std::snprintf(str,32,"%e",value);
+
+            char digits[18];
+            int length=0;
+            int exponent=0;
+            if(value==0.)
+                return write_scientific(std::signbit(value),"0",1,0,str);
+            if(shortest_digits(std::fabs(value),digits,length,exponent))
+                return write_scientific(value<0,digits,static_cast<std::size_t>(length),exponent+length-1,str);
+
+            char full[32];
+            for(int precision=14; precision<16; precision++)
+            {
+                std::snprintf(full,sizeof(full),"%.*e",precision,value);
+                if(std::strtod(full,nullptr)==value)
+                    return compact_scientific(full,str);
+            }
+            std::snprintf(full,sizeof(full),"%.16e",value);
+            return compact_scientific(full,str);
+        }
+
+    private:
+        void new_line()
+        {
+            if(!fBuffer.empty())
+                fBuffer+='\n';
+        }
+
+        void end_line()
+        {
+            if(fBuffer.size()>=fBlock_size)
+                flush();
+        }
+
+        void append_value(double value)
+        {
+            char str[32];
+            int n = fFormat==kRoundTrip ? format_round_trip(value,str) : format_scientific(value,str);
+            append_centered(str,n>0 ? static_cast<std::size_t>(n) : 0);
+        }
+
+        // same as "<< std::setw(width) << bstream_centered(str)"
+        void append_centered(const char* str, std::size_t length)
+        {
+            if(length<fWidth)
+            {
+                std::size_t left=(fWidth+length)/2;
+                fBuffer.append(left-length,' ');
+                fBuffer.append(str,length);
+                fBuffer.append(fWidth-left,' ');
+            }
+            else
+                fBuffer.append(str,length);
+        }
+
+        // "%e" output full written as [-]d.ddde+XX without the trailing zeros of the mantissa
+        static int compact_scientific(const char* full, char* str)
+        {
+            const char* c=full;
+            bool negative = *c=='-';
+            if(negative)
+                ++c;
+            char digits[17];
+            std::size_t count=0;
+            for(; *c!='e'; c++)
+                if(*c>='0' && *c<='9' && count<sizeof(digits))
+                    digits[count++]=*c;
+            return write_scientific(negative,digits,count,std::atoi(c+1),str);
+        }
+
+        // [-]d.ddde+XX from count significant digits, without the trailing zeros
+        static int write_scientific(bool negative, const char* digits, std::size_t count, int exponent, char* str)
+        {
+            while(count>1 && digits[count-1]=='0')
+                --count;
+            char* c=str;
+            if(negative)
+                *c++='-';
+            *c++=digits[0];
+            if(count>1)
+            {
+                *c++='.';
+                std::memcpy(c,digits+1,count-1);
+                c+=count-1;
+            }
+            *c++='e';
+            *c++= exponent<0 ? '-' : '+';
+            int abs_exponent= exponent<0 ? -exponent : exponent;
+            if(abs_exponent>=100)
+                *c++=static_cast<char>('0'+abs_exponent/100);
+            *c++=static_cast<char>('0'+(abs_exponent/10)%10);
+            *c++=static_cast<char>('0'+abs_exponent%10);
+            *c='\0';
+            return static_cast<int>(c-str);
+        }
+
+        /// //////////////////////////////////////////////////////////////////////////
+        /// Grisu3 (F. Loitsch, "Printing floating-point numbers quickly and         //
+        /// accurately with integers", PLDI 2010) : the digits of v (> 0, finite)   //
+        /// are generated from a 64 bit approximation of v 10^-k and of the         //
+        /// boundaries of its rounding interval, with a cached power of ten. Return //
+        /// false if the shortest and closest digits cannot be guaranteed, otherwise //
+        /// v ~ digits 10^exponent (length digits, at most 17)                       //
+        /// //////////////////////////////////////////////////////////////////////////
+
+        // f 2^e
+        struct diy_fp
+        {
+            std::uint64_t f;
+            int e;
+        };
+
+        static diy_fp normalize(diy_fp x)
+        {
+            while(!(x.f & (std::uint64_t(1)<<63)))
+            {
+                x.f<<=1;
+                --x.e;
+            }
+            return x;
+        }
+
+        // x y rounded to 64 bits
+        static diy_fp multiply(const diy_fp& x, const diy_fp& y)
+        {
+            const std::uint64_t mask=0xffffffffULL;
+            const std::uint64_t a=x.f>>32, b=x.f&mask, c=y.f>>32, d=y.f&mask;
+            const std::uint64_t ac=a*c, bc=b*c, ad=a*d, bd=b*d;
+            const std::uint64_t middle=(bd>>32)+(ad&mask)+(bc&mask)+(1ULL<<31);
+            return diy_fp{ac+(ad>>32)+(bc>>32)+(middle>>32),x.e+y.e+64};
+        }
+
+        // 10^k ~ f 2^e (normalized, rounded to nearest) for k = -348, -340, ..., 340, such
+        // that the exponent of w 10^k is in [-60,-32] for the exponent e of w
+        static diy_fp cached_power(int e, int& k)
+        {
+            struct power { std::uint64_t f; short e; short k; };
+            static const power powers[87]={
+                {0xfa8fd5a0081c0288ULL,-1220,-348}, {0xbaaee17fa23ebf76ULL,-1193,-340},
+                {0x8b16fb203055ac76ULL,-1166,-332}, {0xcf42894a5dce35eaULL,-1140,-324},
+                {0x9a6bb0aa55653b2dULL,-1113,-316}, {0xe61acf033d1a45dfULL,-1087,-308},
+                {0xab70fe17c79ac6caULL,-1060,-300}, {0xff77b1fcbebcdc4fULL,-1034,-292},
+                {0xbe5691ef416bd60cULL,-1007,-284}, {0x8dd01fad907ffc3cULL, -980,-276},
+                {0xd3515c2831559a83ULL, -954,-268}, {0x9d71ac8fada6c9b5ULL, -927,-260},
+                {0xea9c227723ee8bcbULL, -901,-252}, {0xaecc49914078536dULL, -874,-244},
+                {0x823c12795db6ce57ULL, -847,-236}, {0xc21094364dfb5637ULL, -821,-228},
+                {0x9096ea6f3848984fULL, -794,-220}, {0xd77485cb25823ac7ULL, -768,-212},
+                {0xa086cfcd97bf97f4ULL, -741,-204}, {0xef340a98172aace5ULL, -715,-196},
+                {0xb23867fb2a35b28eULL, -688,-188}, {0x84c8d4dfd2c63f3bULL, -661,-180},
+                {0xc5dd44271ad3cdbaULL, -635,-172}, {0x936b9fcebb25c996ULL, -608,-164},
+                {0xdbac6c247d62a584ULL, -582,-156}, {0xa3ab66580d5fdaf6ULL, -555,-148},
+                {0xf3e2f893dec3f126ULL, -529,-140}, {0xb5b5ada8aaff80b8ULL, -502,-132},
+                {0x87625f056c7c4a8bULL, -475,-124}, {0xc9bcff6034c13053ULL, -449,-116},
+                {0x964e858c91ba2655ULL, -422,-108}, {0xdff9772470297ebdULL, -396,-100},
+                {0xa6dfbd9fb8e5b88fULL, -369, -92}, {0xf8a95fcf88747d94ULL, -343, -84},
+                {0xb94470938fa89bcfULL, -316, -76}, {0x8a08f0f8bf0f156bULL, -289, -68},
+                {0xcdb02555653131b6ULL, -263, -60}, {0x993fe2c6d07b7facULL, -236, -52},
+                {0xe45c10c42a2b3b06ULL, -210, -44}, {0xaa242499697392d3ULL, -183, -36},
+                {0xfd87b5f28300ca0eULL, -157, -28}, {0xbce5086492111aebULL, -130, -20},
+                {0x8cbccc096f5088ccULL, -103, -12}, {0xd1b71758e219652cULL,  -77,  -4},
+                {0x9c40000000000000ULL,  -50,   4}, {0xe8d4a51000000000ULL,  -24,  12},
+                {0xad78ebc5ac620000ULL,    3,  20}, {0x813f3978f8940984ULL,   30,  28},
+                {0xc097ce7bc90715b3ULL,   56,  36}, {0x8f7e32ce7bea5c70ULL,   83,  44},
+                {0xd5d238a4abe98068ULL,  109,  52}, {0x9f4f2726179a2245ULL,  136,  60},
+                {0xed63a231d4c4fb27ULL,  162,  68}, {0xb0de65388cc8ada8ULL,  189,  76},
+                {0x83c7088e1aab65dbULL,  216,  84}, {0xc45d1df942711d9aULL,  242,  92},
+                {0x924d692ca61be758ULL,  269, 100}, {0xda01ee641a708deaULL,  295, 108},
+                {0xa26da3999aef774aULL,  322, 116}, {0xf209787bb47d6b85ULL,  348, 124},
+                {0xb454e4a179dd1877ULL,  375, 132}, {0x865b86925b9bc5c2ULL,  402, 140},
+                {0xc83553c5c8965d3dULL,  428, 148}, {0x952ab45cfa97a0b3ULL,  455, 156},
+                {0xde469fbd99a05fe3ULL,  481, 164}, {0xa59bc234db398c25ULL,  508, 172},
+                {0xf6c69a72a3989f5cULL,  534, 180}, {0xb7dcbf5354e9beceULL,  561, 188},
+                {0x88fcf317f22241e2ULL,  588, 196}, {0xcc20ce9bd35c78a5ULL,  614, 204},
+                {0x98165af37b2153dfULL,  641, 212}, {0xe2a0b5dc971f303aULL,  667, 220},
+                {0xa8d9d1535ce3b396ULL,  694, 228}, {0xfb9b7cd9a4a7443cULL,  720, 236},
+                {0xbb764c4ca7a44410ULL,  747, 244}, {0x8bab8eefb6409c1aULL,  774, 252},
+                {0xd01fef10a657842cULL,  800, 260}, {0x9b10a4e5e9913129ULL,  827, 268},
+                {0xe7109bfba19c0c9dULL,  853, 276}, {0xac2820d9623bf429ULL,  880, 284},
+                {0x80444b5e7aa7cf85ULL,  907, 292}, {0xbf21e44003acdd2dULL,  933, 300},
+                {0x8e679c2f5e44ff8fULL,  960, 308}, {0xd433179d9c8cb841ULL,  986, 316},
+                {0x9e19db92b4e31ba9ULL, 1013, 324}, {0xeb96bf6ebadf77d9ULL, 1039, 332},
+                {0xaf87023b9bf0ee6bULL, 1066, 340},
+            };
+            const int min_exponent=-60-(e+64);
+            const int index=(348+static_cast<int>(std::ceil((min_exponent+63)*0.30102999566398114))-1)/8+1;
+            k=powers[index].k;
+            return diy_fp{powers[index].f,powers[index].e};
+        }
+
+        // largest power of ten <= n (n < 10^10), and its number of digits
+        static void biggest_power_ten(std::uint32_t n, std::uint32_t& power, int& digits)
+        {
+            power=1;
+            digits=1;
+            while(digits<10 && n>=power*10)
+            {
+                power*=10;
+                ++digits;
+            }
+        }
+
+        // moves the last digit towards w while the digits stay in the safe interval, and
+        // checks that the result is closer to w than its neighbours
+        static bool round_weed(char* digits, int length, std::uint64_t distance_too_high_w,
+                               std::uint64_t unsafe_interval, std::uint64_t rest,
+                               std::uint64_t ten_kappa, std::uint64_t unit)
+        {
+            const std::uint64_t small_distance=distance_too_high_w-unit;
+            const std::uint64_t big_distance=distance_too_high_w+unit;
+            while(rest<small_distance && unsafe_interval-rest>=ten_kappa
+                  && (rest+ten_kappa<small_distance || small_distance-rest>=rest+ten_kappa-small_distance))
+            {
+                --digits[length-1];
+                rest+=ten_kappa;
+            }
+            if(rest<big_distance && unsafe_interval-rest>=ten_kappa
+               && (rest+ten_kappa<big_distance || big_distance-rest>rest+ten_kappa-big_distance))
+                return false;
+            return 2*unit<=rest && rest<=unsafe_interval-4*unit;
+        }
+
+        static bool shortest_digits(double v, char* digits, int& length, int& exponent)
+        {
+            // v = f 2^e and the boundaries m- and m+ of its rounding interval
+            const std::uint64_t hidden_bit=1ULL<<52;
+            std::uint64_t bits;
+            std::memcpy(&bits,&v,sizeof(bits));
+            const int biased_e=static_cast<int>((bits>>52)&0x7ff);
+            diy_fp w= biased_e ? diy_fp{(bits&(hidden_bit-1))|hidden_bit,biased_e-1075}
+                               : diy_fp{bits&(hidden_bit-1),-1074};
+            diy_fp plus=normalize(diy_fp{(w.f<<1)+1,w.e-1});
+            diy_fp minus= (w.f==hidden_bit && biased_e>1) ? diy_fp{(w.f<<2)-1,w.e-2} : diy_fp{(w.f<<1)-1,w.e-1};
+            minus.f<<=minus.e-plus.e;
+            minus.e=plus.e;
+            w=normalize(w);
+
+            int k=0;
+            const diy_fp c=cached_power(w.e,k);
+            const diy_fp scaled_w=multiply(w,c);
+            const diy_fp low=multiply(minus,c);
+            const diy_fp high=multiply(plus,c);
+
+            // digits of too_high, the last one within the unsafe interval : the integral
+            // part first, then the fractional part
+            std::uint64_t unit=1;
+            const std::uint64_t too_low=low.f-unit;
+            const std::uint64_t too_high=high.f+unit;
+            std::uint64_t unsafe_interval=too_high-too_low;
+            const int shift=-scaled_w.e;
+            const std::uint64_t one=1ULL<<shift;
+            std::uint32_t integrals=static_cast<std::uint32_t>(too_high>>shift);
+            std::uint64_t fractionals=too_high&(one-1);
+            std::uint32_t divisor;
+            int kappa;
+            biggest_power_ten(integrals,divisor,kappa);
+            length=0;
+            while(kappa>0)
+            {
+                digits[length++]=static_cast<char>('0'+integrals/divisor);
+                integrals%=divisor;
+                --kappa;
+                const std::uint64_t rest=(static_cast<std::uint64_t>(integrals)<<shift)+fractionals;
+                if(rest<unsafe_interval)
+                {
+                    exponent=kappa-k;
+                    return round_weed(digits,length,too_high-scaled_w.f,unsafe_interval,rest,
+                                      static_cast<std::uint64_t>(divisor)<<shift,unit);
+                }
+                divisor/=10;
+            }
+            while(length<17)
+            {
+                fractionals*=10;
+                unit*=10;
+                unsafe_interval*=10;
+                digits[length++]=static_cast<char>('0'+(fractionals>>shift));
+                fractionals&=one-1;
+                --kappa;
+                if(fractionals<unsafe_interval)
+                {
+                    exponent=kappa-k;
+                    return round_weed(digits,length,(too_high-scaled_w.f)*unit,unsafe_interval,fractionals,one,unit);
+                }
+            }
+            return false;
+        }
+
+        sink_type fSink;
+        format fFormat;
+        std::size_t fWidth;         // column width
+        std::size_t fBlock_size;    // the buffer is flushed beyond this size
+        std::string fBuffer;
+    };
+}
+
+#endif	/* TABLE_WRITER_H */
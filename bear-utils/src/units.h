@@ -0,0 +1,74 @@
+/*
+ * File:   units.h
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef UNITS_H
+#define	UNITS_H
+
+#include <map>
+#include <string>
+
+namespace bear
+{
+    // 6.022140857(74)×10^23 mol^-1
+    const double avogadro_number = 6.022140857e+23;
+
+    // areal density units of the thickness, in g/cm2
+    inline const std::map<std::string, double>& thickness_units()
+    {
+        static const std::map<std::string, double> units =
+        {
+            {"fg/cm2",      1.e-15},    // femto
+            {"pg/cm2",      1.e-12},    // pico
+            {"ng/cm2",      1.e-9},     // nano
+            {"mug/cm2",     1.e-6},     // micro
+            {"mg/cm2",      1.e-3},     // milli
+            {"cg/cm2",      1.e-2},     // centi
+            {"10 mg/cm2",   1.e-2},     // centi
+            {"g/cm2",       1.},        // no prefix
+            {"kg/cm2",      1.e+3},     // kilo
+            {"Mg/cm2",      1.e+6},     // Mega
+            {"Gg/cm2",      1.e+9},     // Giga
+            {"Tg/cm2",      1.e+12},    // Tera
+            {"Pg/cm2",      1.e+15}     // Peta
+        };
+        return units;
+    }
+
+    // cross-section units, in cm2
+    inline const std::map<std::string, double>& cross_section_units()
+    {
+        static const std::map<std::string, double> units =
+        {
+            {"cm2",         1.},
+            {"1e-16 cm2",   1.e-16},
+            {"pb",          1.e-36},
+            {"nb",          1.e-33},
+            {"mub",         1.e-30},
+            {"mb",          1.e-27},
+            {"b",           1.e-24},
+            {"kb",          1.e-21},
+            {"Mb",          1.e-18},
+            {"Gb",          1.e-15},
+            {"Tb",          1.e-12}
+        };
+        return units;
+    }
+
+    // factor from the cross-sections to the reaction probabilities per unit thickness of a
+    // target of given mass number : sigma * N_A / A * (thickness unit), return 1 if a unit is unknown
+    inline int scale_factor(const std::string& cross_section_unit, const std::string& thickness_unit,
+                            double target_mass_number, double& factor)
+    {
+        auto cs=cross_section_units().find(cross_section_unit);
+        auto x=thickness_units().find(thickness_unit);
+        if(cs==cross_section_units().end() || x==thickness_units().end())
+            return 1;
+        factor=cs->second*x->second*avogadro_number/target_mass_number;
+        return 0;
+    }
+}
+
+#endif	/* UNITS_H */